@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/// Interface for a OneWire bus master.
+///
+/// ROM codes are 64-bit values in wire order: family code in the low byte,
+/// CRC in the high byte, bit 0 sent first.
+class IOneWireBus {
+public:
+    virtual ~IOneWireBus() = default;
+
+    /// Reset pulse. Returns true if at least one device answered with a
+    /// presence pulse.
+    virtual bool reset() = 0;
+
+    virtual bool writeBytes(const uint8_t* data, size_t length) = 0;
+    virtual bool readBytes(uint8_t* data, size_t length) = 0;
+    virtual bool writeBit(uint8_t bit) = 0;
+    virtual bool readBit(uint8_t& bit) = 0;
+
+    /// Enumerate every device with Search ROM (0xF0). Returns false on a bus
+    /// error; `count` then holds the devices found so far.
+    virtual bool search(uint64_t* addresses, size_t maxCount, size_t& count) {
+        count = 0;
+        uint64_t rom = 0;
+        int lastDiscrepancy = -1;
+
+        while (count < maxCount) {
+            if (!reset()) return true;                  // empty bus
+
+            const uint8_t cmd = 0xF0;
+            if (!writeBytes(&cmd, 1)) return false;
+
+            int discrepancy = -1;
+            for (int i = 0; i < 64; ++i) {
+                uint8_t bit = 0, complement = 0;
+                if (!readBit(bit) || !readBit(complement)) return false;
+                if (bit && complement) return false;    // device left mid-search
+
+                uint8_t direction;
+                if (bit != complement) {
+                    direction = bit;
+                } else {
+                    // Both values present: retrace the previous path up to the
+                    // last fork, take 1 there, and 0 on every fork after it
+                    direction = i < lastDiscrepancy ? (rom >> i) & 1 : (i == lastDiscrepancy);
+                    if (!direction) discrepancy = i;
+                }
+
+                rom = (rom & ~(1ull << i)) | (static_cast<uint64_t>(direction) << i);
+                if (!writeBit(direction)) return false;
+            }
+
+            if (crc8(reinterpret_cast<const uint8_t*>(&rom), 7) != static_cast<uint8_t>(rom >> 56))
+                return false;
+            addresses[count++] = rom;
+
+            lastDiscrepancy = discrepancy;
+            if (lastDiscrepancy < 0) break;
+        }
+        return true;
+    }
+
+    /// Dallas/Maxim CRC-8 (polynomial x^8 + x^5 + x^4 + 1), as used for ROM
+    /// codes and DS18B20 scratchpads.
+    static uint8_t crc8(const uint8_t* data, size_t length) {
+        uint8_t crc = 0;
+        for (size_t i = 0; i < length; ++i) {
+            uint8_t byte = data[i];
+            for (int b = 0; b < 8; ++b) {
+                uint8_t mix = (crc ^ byte) & 0x01;
+                crc >>= 1;
+                if (mix) crc ^= 0x8C;
+                byte >>= 1;
+            }
+        }
+        return crc;
+    }
+};
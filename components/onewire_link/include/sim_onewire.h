@@ -0,0 +1,271 @@
+#pragma once
+
+#include "onewire_link.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+/// One simulated DS18B20 and its fault model.
+struct SimDevice {
+    uint64_t rom = 0;
+    float temperatureC = 20.0f;     // true temperature, sampled when a conversion starts
+    float noiseC = 0.0f;            // standard deviation added to every conversion
+    float dropoutRate = 0.0f;       // chance per reset that the device does not answer
+    float crcErrorRate = 0.0f;      // chance per scratchpad read that one bit flips
+    bool connected = true;
+};
+
+/// In-memory OneWire bus populated with DS18B20s that speak the real protocol:
+///  - Reset reports the presence pulse of every connected device
+///  - Skip ROM, Match ROM and Search ROM select devices; devices answering
+///    together are wired-AND, as on a real bus
+///  - Convert T takes 93.75-750 ms depending on the configured resolution;
+///    reading earlier returns the previous result (85 °C after power-on)
+///  - Write Scratchpad sets TH, TL and the resolution
+/// Every transfer completes instantly. Nothing here depends on ESP-IDF.
+class SimOneWireBus : public IOneWireBus {
+public:
+    explicit SimOneWireBus(uint32_t seed = 1) : rng(seed) {}
+
+    /// Add a device; it starts in the power-on state.
+    void addDevice(const SimDevice& config) {
+        Device device;
+        device.sim = config;
+        const uint8_t powerOn[8] = { 0x50, 0x05, 0x4B, 0x46, 0x7F, 0xFF, 0x0C, 0x10 };
+        std::memcpy(device.scratchpad, powerOn, sizeof(powerOn));
+        device.scratchpad[8] = crc8(device.scratchpad, 8);
+        devices.push_back(device);
+    }
+
+    /// Live access to a device's settings (temperature, faults, connected).
+    SimDevice& device(size_t index) { return devices[index].sim; }
+    size_t deviceCount() const { return devices.size(); }
+
+    /// Replace the wall clock, e.g. to step time in a host test.
+    void setClock(std::function<int64_t()> nowUs) { clock = std::move(nowUs); }
+
+    /// DS18B20 ROM code with a valid CRC for a 48-bit serial number.
+    static uint64_t makeRom(uint64_t serial, uint8_t family = 0x28) {
+        uint64_t rom = family | ((serial & 0xFFFFFFFFFFFFull) << 8);
+        uint8_t crc = crc8(reinterpret_cast<const uint8_t*>(&rom), 7);
+        return rom | (static_cast<uint64_t>(crc) << 56);
+    }
+
+    // --- IOneWireBus ---
+
+    bool reset() override {
+        bool presence = false;
+        for (auto& device : devices) {
+            settle(device);
+            device.answering = device.sim.connected && !chance(device.sim.dropoutRate);
+            device.selected = false;
+            presence |= device.answering;
+        }
+        phase = Phase::RomCommand;
+        receivedCount = 0;
+        output.clear();
+        outputBit = 0;
+        pendingBits = 0;
+        pendingBitCount = 0;
+        return presence;
+    }
+
+    bool writeBytes(const uint8_t* data, size_t length) override {
+        for (size_t i = 0; i < length; ++i)
+            handleByte(data[i]);
+        return true;
+    }
+
+    bool readBytes(uint8_t* data, size_t length) override {
+        for (size_t i = 0; i < length; ++i) {
+            uint8_t byte = 0;
+            for (int b = 0; b < 8; ++b) {
+                uint8_t bit;
+                readBit(bit);
+                byte |= bit << b;
+            }
+            data[i] = byte;
+        }
+        return true;
+    }
+
+    bool writeBit(uint8_t bit) override {
+        if (phase == Phase::Search) {
+            // Direction chosen by the master: the other branch drops out
+            if (searchStep == 2) {
+                for (auto& device : devices)
+                    if (device.selected && ((device.sim.rom >> searchBit) & 1) != (bit & 1))
+                        device.selected = false;
+                searchStep = 0;
+                if (++searchBit == 64) phase = Phase::Function;
+            }
+            return true;
+        }
+
+        pendingBits |= (bit & 1) << pendingBitCount;
+        if (++pendingBitCount == 8) {
+            handleByte(pendingBits);
+            pendingBits = 0;
+            pendingBitCount = 0;
+        }
+        return true;
+    }
+
+    bool readBit(uint8_t& bit) override {
+        if (phase == Phase::Search && searchStep < 2) {
+            // Wired-AND of the ROM bit (or its complement) of every
+            // device still on the path; an idle line reads 1
+            bit = 1;
+            for (auto& device : devices) {
+                if (!device.selected) continue;
+                uint8_t value = (device.sim.rom >> searchBit) & 1;
+                bit &= searchStep == 0 ? value : !value;
+            }
+            searchStep++;
+            return true;
+        }
+
+        bit = 1;
+        if (outputBit < output.size() * 8) {
+            bit = (output[outputBit / 8] >> (outputBit % 8)) & 1;
+            outputBit++;
+        }
+        return true;
+    }
+
+private:
+    enum class Phase { Idle, RomCommand, MatchRom, Search, Function, WriteScratchpad };
+
+    struct Device {
+        SimDevice sim;
+        uint8_t scratchpad[9] = {};
+        int16_t result = 0;             // value of the running conversion
+        int64_t conversionEndUs = -1;   // -1 = no conversion running
+        bool answering = false;         // took part in the last reset
+        bool selected = false;
+    };
+
+    std::vector<Device> devices;
+    std::mt19937 rng;
+    std::function<int64_t()> clock;
+
+    Phase phase = Phase::Idle;
+    uint8_t received[8] = {};
+    size_t receivedCount = 0;
+    int searchBit = 0;
+    int searchStep = 0;                 // 0 = bit, 1 = complement, 2 = direction
+    std::vector<uint8_t> output;
+    size_t outputBit = 0;
+    uint8_t pendingBits = 0;
+    int pendingBitCount = 0;
+
+    int64_t nowUs() const {
+        if (clock) return clock();
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    bool chance(float rate) {
+        return rate > 0.0f && std::uniform_real_distribution<float>(0.0f, 1.0f)(rng) < rate;
+    }
+
+    static int resolutionOf(const Device& device) { return (device.scratchpad[4] >> 5) & 0x03; }
+
+    // Finish a conversion once its time is up
+    void settle(Device& device) {
+        if (device.conversionEndUs < 0 || nowUs() < device.conversionEndUs) return;
+        device.scratchpad[0] = static_cast<uint8_t>(device.result);
+        device.scratchpad[1] = static_cast<uint8_t>(device.result >> 8);
+        device.scratchpad[8] = crc8(device.scratchpad, 8);
+        device.conversionEndUs = -1;
+    }
+
+    void startConversion(Device& device) {
+        float value = device.sim.temperatureC;
+        if (device.sim.noiseC > 0.0f)
+            value += std::normal_distribution<float>(0.0f, device.sim.noiseC)(rng);
+
+        // Low bits below the resolution read as zero
+        int resolution = resolutionOf(device);
+        int16_t raw = static_cast<int16_t>(std::lround(value * 16.0f));
+        device.result = static_cast<int16_t>(raw & ~((1 << (3 - resolution)) - 1));
+        device.conversionEndUs = nowUs() + (93750 << resolution);
+    }
+
+    void handleByte(uint8_t byte) {
+        switch (phase) {
+        case Phase::RomCommand:
+            if (byte == 0xCC) {             // Skip ROM
+                for (auto& device : devices) device.selected = device.answering;
+                phase = Phase::Function;
+            } else if (byte == 0x55) {      // Match ROM
+                receivedCount = 0;
+                phase = Phase::MatchRom;
+            } else if (byte == 0xF0) {      // Search ROM
+                for (auto& device : devices) device.selected = device.answering;
+                searchBit = 0;
+                searchStep = 0;
+                phase = Phase::Search;
+            } else {
+                phase = Phase::Idle;
+            }
+            break;
+
+        case Phase::MatchRom:
+            received[receivedCount++] = byte;
+            if (receivedCount == 8) {
+                uint64_t rom;
+                std::memcpy(&rom, received, sizeof(rom));
+                for (auto& device : devices) device.selected = device.answering && device.sim.rom == rom;
+                phase = Phase::Function;
+            }
+            break;
+
+        case Phase::Function:
+            if (byte == 0x44) {             // Convert T
+                for (auto& device : devices)
+                    if (device.selected) startConversion(device);
+                phase = Phase::Idle;
+            } else if (byte == 0xBE) {      // Read Scratchpad
+                output.assign(9, 0xFF);
+                for (auto& device : devices) {
+                    if (!device.selected) continue;
+                    uint8_t data[9];
+                    std::memcpy(data, device.scratchpad, sizeof(data));
+                    if (chance(device.sim.crcErrorRate))
+                        data[rng() % 9] ^= static_cast<uint8_t>(1u << (rng() % 8));
+                    for (int i = 0; i < 9; ++i) output[i] &= data[i];
+                }
+                outputBit = 0;
+                phase = Phase::Idle;
+            } else if (byte == 0x4E) {      // Write Scratchpad
+                receivedCount = 0;
+                phase = Phase::WriteScratchpad;
+            } else {
+                phase = Phase::Idle;
+            }
+            break;
+
+        case Phase::WriteScratchpad:
+            received[receivedCount++] = byte;
+            if (receivedCount == 3) {
+                for (auto& device : devices) {
+                    if (!device.selected) continue;
+                    device.scratchpad[2] = received[0];
+                    device.scratchpad[3] = received[1];
+                    device.scratchpad[4] = static_cast<uint8_t>((received[2] & 0x60) | 0x1F);
+                    device.scratchpad[8] = crc8(device.scratchpad, 8);
+                }
+                phase = Phase::Idle;
+            }
+            break;
+
+        case Phase::Search:
+        case Phase::Idle:
+            break;
+        }
+    }
+};
@@ -205,6 +205,10 @@ class BackendService {
     return this.send<TemperaturesResponse>("getTemperatures")
   }
 
+  async setSensorResolution(slot: number, bits: number): Promise<{ ok: boolean; error?: string }> {
+    return this.send("setSensorResolution", { slot, bits })
+  }
+
   async getLogEntries(offset = 0, limit = 50): Promise<LogEntriesResponse> {
     return this.send<LogEntriesResponse>("getLogEntries", { offset, limit })
   }
@@ -213,6 +217,34 @@ class BackendService {
     return this.send("eraseLog")
   }
 
+  async getHistory(from: number, to?: number, resolution?: number, limit?: number): Promise<HistoryResponse> {
+    return this.send<HistoryResponse>("getHistory", { from, to, resolution, limit })
+  }
+
+  async getStats(): Promise<StatsResponse> {
+    return this.send<StatsResponse>("getStats")
+  }
+
+  async getMetrics(): Promise<MetricsResponse> {
+    return this.send<MetricsResponse>("getMetrics")
+  }
+
+  async burstStart(): Promise<{ ok: boolean; error?: string }> {
+    return this.send("burstStart")
+  }
+
+  async burstStop(): Promise<{ ok: boolean }> {
+    return this.send("burstStop")
+  }
+
+  async getBursts(): Promise<BurstListResponse> {
+    return this.send<BurstListResponse>("getBursts")
+  }
+
+  async getBurst(index: number, offset = 0, limit = 200): Promise<BurstCaptureResponse> {
+    return this.send<BurstCaptureResponse>("getBurst", { index, offset, limit })
+  }
+
   async uploadFirmware(
     file: File,
     onProgress?: (percent: number) => void,
@@ -320,9 +352,12 @@ export interface SensorReading {
   active: boolean
   address: string
   temperature: number
+  resolution: number
 }
 
 export interface TemperaturesResponse {
+  sequence: number
+  ageMs: number
   sensors: SensorReading[]
 }
 
@@ -336,3 +371,134 @@ export interface LogEntriesResponse {
   entries: RawLogEntry[]
 }
 
+// [timestamp, count, avg0, min0, max0, ... avg3, min3, max3] in centi-°C, null when the slot had no data
+export type HistoryPoint = (number | null)[]
+
+export interface HistoryResponse {
+  from: number
+  to: number
+  resolution: number
+  source: "raw" | "minute" | "hour" | "day" | "cache"
+  points: HistoryPoint[]
+}
+
+export interface WindowStats {
+  count: number
+  min: number
+  max: number
+  mean: number
+  stddev: number
+}
+
+// Keyed by window name ("1h", "24h", "7d"); null until the window has data
+export interface SlotStats {
+  slot: number
+  [window: string]: WindowStats | number | null
+}
+
+export interface StatsResponse {
+  windows: string[]
+  slots: SlotStats[]
+}
+
+export interface SamplerMetrics {
+  rate: number
+  samples: number
+  missedDeadlines: number
+  lastLatenessMs: number
+  maxLatenessMs: number
+  staleSamples: number
+  clockSteps: number
+  entriesWritten: number
+  slotsSuppressed: number
+}
+
+export interface BusMetrics {
+  gpio: number
+  sensors: number
+  lastReadUs: number
+  maxReadUs: number
+  errors: number
+  searches: number
+  rejected: number
+}
+
+export interface SensorMetrics {
+  cycleUs: number
+  buses: BusMetrics[]
+}
+
+// activeMask: bit (slot * 3 + kind) per raised alarm, kind 0 = high, 1 = low, 2 = rate
+export interface AlarmMetrics {
+  activeMask: number
+  raised: number
+  cleared: number
+  dropped: number
+  lastLatencyUs: number
+  maxLatencyUs: number
+}
+
+// Over the last second
+export interface DisplayMetrics {
+  fps: number
+  frameCpuUs: number
+  frameBlockedUs: number
+  bufferLines: number
+  bufferInPsram: boolean
+  taskLoadPct: number
+  wakeups: number
+  screen: "on" | "dim" | "off"
+  touchIrqs: number
+  touchReads: number
+  navigations: number
+  lastNavigateUs: number
+  maxNavigateUs: number
+  pagesCreated: number
+  pagesReused: number
+  pagesEvicted: number
+  lvglMemFree: number
+  lvglMemBiggest: number
+  lvglMemFragPct: number
+}
+
+export interface MetricsResponse {
+  sampler: SamplerMetrics
+  sensors: SensorMetrics
+  alarms: AlarmMetrics
+  display: DisplayMetrics
+}
+
+// Pushed as {"alarm": AlarmEvent} on every alarm transition; value is null
+// when the alarm was cleared because the sensor was lost
+export interface AlarmEvent {
+  slot: number
+  type: "high" | "low" | "rate"
+  active: boolean
+  value: number | null
+  limit: number
+  time: number
+}
+
+// source: 0 = command, 1 = MQTT, 2 = threshold
+export interface BurstSummary {
+  index: number
+  startUtc: number
+  triggerOffsetMs: number
+  durationMs: number
+  sampleCount: number
+  source: number
+  resolution: number
+}
+
+export interface BurstListResponse {
+  capturing: boolean
+  captures: BurstSummary[]
+}
+
+// [msSinceStart, t0, t1, t2, t3] in centi-°C, null when the slot had no data
+export type BurstSample = (number | null)[]
+
+export interface BurstCaptureResponse extends Omit<BurstSummary, "source"> {
+  offset: number
+  samples: BurstSample[]
+}
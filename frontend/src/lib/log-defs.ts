@@ -8,8 +8,29 @@ export const LogKey = {
   Temperature_4: 5,
   IpAddress: 6,
   FirmwareVersion: 7,
+  SampleCount: 8,
+  // Packed min/max: low 16 bits = min, high 16 bits = max (centi-°C)
+  TemperatureRange_1: 9,
+  TemperatureRange_2: 10,
+  TemperatureRange_3: 11,
+  TemperatureRange_4: 12,
+  // Slot in the low byte, kind (0 = high, 1 = low, 2 = rate) in the next
+  AlarmInfo: 13,
+  // Float: °C, or °C/min for a rate alarm
+  AlarmValue: 14,
+  // Sensors past the four channels: key = SensorTemperature_0 + sensor id
+  SensorTemperature_0: 64,
+  SensorTemperature_Last: 127,
 } as const
 
+// Sensor id stored under a temperature key, or undefined for any other key
+export function sensorForTemperatureKey(key: number): number | undefined {
+  if (key >= LogKey.Temperature_1 && key <= LogKey.Temperature_4) return key - LogKey.Temperature_1
+  if (key >= LogKey.SensorTemperature_0 + 4 && key <= LogKey.SensorTemperature_Last)
+    return key - LogKey.SensorTemperature_0
+  return undefined
+}
+
 // Must match LogCode enum in LogDefs.h
 export const LogCodeValue = {
   SystemBoot: 0,
@@ -22,6 +43,10 @@ export const LogCodeValue = {
   ApStarted: 7,
   ApFallback: 8,
   TemperatureReading: 9,
+  TemperatureRollup: 10,
+  BurstCaptured: 11,
+  AlarmRaised: 12,
+  AlarmCleared: 13,
 } as const
 
 export const LogCodeName: Record<number, string> = {
@@ -35,8 +60,14 @@ export const LogCodeName: Record<number, string> = {
   7: "ApStarted",
   8: "ApFallback",
   9: "TemperatureReading",
+  10: "TemperatureRollup",
+  11: "BurstCaptured",
+  12: "AlarmRaised",
+  13: "AlarmCleared",
 }
 
+export const AlarmKindName = ["high", "low", "rate"] as const
+
 // Decode IEEE 754 float stored as int32
 const f32Buf = new ArrayBuffer(4)
 const f32View = new DataView(f32Buf)
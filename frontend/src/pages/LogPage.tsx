@@ -3,7 +3,7 @@ import { backend, type RawLogEntry } from "@/lib/backend"
 import { useConnectionStatus } from "@/hooks/use-connection-status"
 import { ScrollTextIcon, RefreshCwIcon, TrashIcon } from "lucide-react"
 import { Button } from "@/components/ui/button"
-import { LogKey, LogCodeName, int32ToFloat } from "@/lib/log-defs"
+import { LogKey, LogCodeName, AlarmKindName, int32ToFloat, sensorForTemperatureKey } from "@/lib/log-defs"
 
 const PAGE_SIZE = 50
 
@@ -23,12 +23,11 @@ function decodeEntry(raw: RawLogEntry): DecodedEntry {
 
   const parts: string[] = []
 
-  for (let i = 0; i < 4; i++) {
-    const key = LogKey.Temperature_1 + i
-    const raw = fields.get(key)
-    if (raw === undefined) continue
+  for (const [key, raw] of fields) {
+    const id = sensorForTemperatureKey(key)
+    if (id === undefined) continue
     const temp = int32ToFloat(raw)
-    if (!isNaN(temp)) parts.push(`T${i + 1}: ${temp.toFixed(1)}\u00B0C`)
+    if (!isNaN(temp)) parts.push(`T${id + 1}: ${temp.toFixed(1)}\u00B0C`)
   }
 
   const ip = fields.get(LogKey.IpAddress)
@@ -41,6 +40,16 @@ function decodeEntry(raw: RawLogEntry): DecodedEntry {
     parts.push(`v${(fw >> 16) & 0xff}.${(fw >> 8) & 0xff}.${fw & 0xff}`)
   }
 
+  const alarm = fields.get(LogKey.AlarmInfo)
+  if (alarm !== undefined) {
+    const kind = (alarm >> 8) & 0xff
+    const value = fields.get(LogKey.AlarmValue)
+    const unit = kind === 2 ? "\u00B0C/min" : "\u00B0C"
+    const v = value !== undefined ? int32ToFloat(value) : undefined
+    const shown = v === undefined ? "" : isNaN(v) ? " sensor lost" : ` ${v.toFixed(1)}${unit}`
+    parts.push(`T${(alarm & 0xff) + 1} ${AlarmKindName[kind] ?? kind}${shown}`)
+  }
+
   return { timestamp, logCode, details: parts.join("  \u00B7  ") }
 }
 
@@ -1,4 +1,4 @@
-import { useEffect, useState, useCallback } from "react"
+import { useEffect, useState, useCallback, useRef } from "react"
 import {
   LineChart,
   Line,
@@ -9,93 +9,135 @@ import {
   ResponsiveContainer,
   Legend,
 } from "recharts"
-import { backend, type RawLogEntry } from "@/lib/backend"
+import { backend, type RawLogEntry, type HistoryPoint } from "@/lib/backend"
 import { useConnectionStatus } from "@/hooks/use-connection-status"
-import { LogKey, LogCodeValue, int32ToFloat } from "@/lib/log-defs"
+import { LogKey, LogCodeValue, int32ToFloat, sensorForTemperatureKey } from "@/lib/log-defs"
 
-const SLOT_COLORS = ["#ef4444", "#3b82f6", "#22c55e", "#eab308"] as const
-const SLOT_NAMES = ["Red", "Blue", "Green", "Yellow"] as const
-const CHART_ENTRIES = 360
+// Ids 0-3 are the colour channels; other ids cycle through a neutral palette
+const CHANNEL_COLORS = ["#ef4444", "#3b82f6", "#22c55e", "#eab308"] as const
+const CHANNEL_NAMES = ["Red", "Blue", "Green", "Yellow"] as const
+const EXTRA_COLORS = ["#a855f7", "#ec4899", "#14b8a6", "#f97316", "#64748b", "#84cc16"] as const
+const CHART_ENTRIES = 360 // samples, on the monitor.rate grid
+const HISTORY_CHUNK = 120 // max points per getHistory response
+const HISTORY_CHANNELS = 4 // getHistory carries avg/min/max for the channels only
 
+const sensorColor = (id: number) =>
+  id < CHANNEL_COLORS.length ? CHANNEL_COLORS[id] : EXTRA_COLORS[(id - CHANNEL_COLORS.length) % EXTRA_COLORS.length]
+const sensorName = (id: number) => (id < CHANNEL_NAMES.length ? CHANNEL_NAMES[id] : `T${id + 1}`)
+const sensorKey = (id: number) => `t${id + 1}`
+
+// One sample on the monitor.rate grid (ts in UTC seconds), one temperature
+// per chart line keyed by sensorKey()
 interface ChartPoint {
+  ts: number
   time: string
-  t1?: number
-  t2?: number
-  t3?: number
-  t4?: number
+  [key: string]: string | number | undefined
 }
 
-function decodeTemps(raw: RawLogEntry): (number | null)[] {
-  const fields = new Map<number, number>()
-  for (const [k, v] of raw) fields.set(k, v)
-  return [
-    LogKey.Temperature_1,
-    LogKey.Temperature_2,
-    LogKey.Temperature_3,
-    LogKey.Temperature_4,
-  ].map((key) => {
-    const bits = fields.get(key)
-    if (bits === undefined) return null
+const emptyPoint = (ts: number): ChartPoint => ({ ts, time: new Date(ts * 1000).toLocaleTimeString() })
+
+// Logging is change-driven: a sensor missing from an entry kept its previous
+// value, a logged NaN (null) means the sensor is gone.
+function decodeTemps(raw: RawLogEntry): Map<number, number | null> {
+  const temps = new Map<number, number | null>()
+  for (const [k, bits] of raw) {
+    const id = sensorForTemperatureKey(k)
+    if (id === undefined) continue
     const v = int32ToFloat(bits)
-    return isNaN(v) ? null : Math.round(v * 10) / 10
-  })
+    temps.set(id, isNaN(v) ? null : Math.round(v * 10) / 10)
+  }
+  return temps
 }
 
-function rawToChartPoint(raw: RawLogEntry): ChartPoint | null {
+// Timestamp of a temperature reading entry, or null for any other entry
+function readingTime(raw: RawLogEntry): number | null {
   const fields = new Map<number, number>()
   for (const [k, v] of raw) fields.set(k, v)
   if (fields.get(LogKey.LogCode) !== LogCodeValue.TemperatureReading) return null
+  return fields.get(LogKey.TimeStamp) || null
+}
+
+// Same step-wise reconstruction as the device's ForEachReconstructed: every
+// grid slot up to `until` repeats the previous values, until nothing was
+// logged for longer than a heartbeat (`maxGap`) and the sensors count as gone.
+function extendGrid(points: ChartPoint[], until: number, rate: number, lastLogged: number, maxGap: number) {
+  const last = points[points.length - 1]
+  if (!last) return points
+  const next = [...points]
+  for (let ts = last.ts + rate; ts <= until; ts += rate) {
+    const carry = ts - lastLogged <= maxGap ? next[next.length - 1] : undefined
+    next.push({ ...carry, ...emptyPoint(ts) })
+  }
+  return next.length > CHART_ENTRIES ? next.slice(-CHART_ENTRIES) : next
+}
+
+// Apply a logged change from the slot holding `ts` onwards
+function applyEntry(points: ChartPoint[], ts: number, temps: Map<number, number | null>) {
+  const next = points.length ? [...points] : [emptyPoint(ts)]
+  let i = next.length - 1
+  while (i > 0 && next[i].ts > ts) i--
+  if (next[i].ts > ts) return points // older than the whole chart
+  for (; i < next.length; i++) {
+    const point = { ...next[i] }
+    for (const [id, t] of temps) {
+      if (t === null) delete point[sensorKey(id)]
+      else point[sensorKey(id)] = t
+    }
+    next[i] = point
+  }
+  return next
+}
 
-  const ts = fields.get(LogKey.TimeStamp) ?? 0
-  const temps = decodeTemps(raw)
-  const point: ChartPoint = {
-    time: ts ? new Date(ts * 1000).toLocaleTimeString() : "",
+function historyToChartPoint(p: HistoryPoint): ChartPoint {
+  const point = emptyPoint(p[0] ?? 0)
+  for (let id = 0; id < HISTORY_CHANNELS; id++) {
+    const avg = p[2 + id * 3]
+    if (avg !== null && avg !== undefined) point[sensorKey(id)] = Math.round(avg / 10) / 10
   }
-  if (temps[0] !== null) point.t1 = temps[0]
-  if (temps[1] !== null) point.t2 = temps[1]
-  if (temps[2] !== null) point.t3 = temps[2]
-  if (temps[3] !== null) point.t4 = temps[3]
   return point
 }
 
 export default function TemperaturePage() {
   const connection = useConnectionStatus()
   const [history, setHistory] = useState<ChartPoint[]>([])
-  const [current, setCurrent] = useState<(number | null)[]>([null, null, null, null])
+  // Latest reading per sensor id, null while the sensor is missing
+  const [current, setCurrent] = useState<Map<number, number | null>>(new Map())
   const [graphRange, setGraphRange] = useState<{ min: number; max: number }>({ min: 0, max: 100 })
+  const [grid, setGrid] = useState<{ rate: number; maxGap: number }>({ rate: 10, maxGap: 610 })
+  const lastLogged = useRef(0) // UTC seconds of the newest logged or fetched reading
 
-  const fetchHistory = useCallback(() => {
-    backend
-      .getLogEntries(0, 1)
-      .then((r) => {
-        const total = r.entryCount
-        const offset = Math.max(0, total - CHART_ENTRIES)
-        return backend.getLogEntries(offset, CHART_ENTRIES)
-      })
-      .then((r) => {
-        const points: ChartPoint[] = []
-        for (const raw of r.entries) {
-          const p = rawToChartPoint(raw)
-          if (p) points.push(p)
-        }
-        setHistory(points)
-        // Set current from the last temperature entry
-        for (let i = r.entries.length - 1; i >= 0; i--) {
-          const fields = new Map<number, number>()
-          for (const [k, v] of r.entries[i]) fields.set(k, v)
-          if (fields.get(LogKey.LogCode) === LogCodeValue.TemperatureReading) {
-            setCurrent(decodeTemps(r.entries[i]))
-            break
-          }
-        }
-      })
-      .catch(() => {})
-
-    backend.getSettings().then((s) => {
+  const fetchHistory = useCallback(async () => {
+    try {
+      const s = await backend.getSettings()
       const min = s.settings.find((x) => x.key === "graph.min")
       const max = s.settings.find((x) => x.key === "graph.max")
       if (min && max) setGraphRange({ min: Number(min.value), max: Number(max.value) })
-    }).catch(() => {})
+      const rate = Math.max(1, Number(s.settings.find((x) => x.key === "monitor.rate")?.value ?? 10))
+      const heartbeat = Number(s.settings.find((x) => x.key === "log.heartbeat")?.value ?? 600)
+      setGrid({ rate, maxGap: heartbeat + rate })
+
+      // The sensor table: the four channels plus every assigned id
+      const t = await backend.getTemperatures()
+      setCurrent(new Map<number, number | null>(t.sensors.map((r) => [
+        r.slot,
+        r.active ? Math.round(r.temperature * 10) / 10 : null,
+      ])))
+
+      // Served from the device's in-RAM history cache, in chunks that fit one response
+      const to = Math.floor(Date.now() / 1000)
+      const chunkSpan = HISTORY_CHUNK * rate
+      const points: HistoryPoint[] = []
+      for (let from = to - CHART_ENTRIES * rate; from < to; from += chunkSpan) {
+        const r = await backend.getHistory(from, Math.min(from + chunkSpan, to), rate, HISTORY_CHUNK)
+        points.push(...r.points)
+      }
+
+      const fetched = points.map(historyToChartPoint)
+      lastLogged.current = fetched[fetched.length - 1]?.ts ?? 0
+      setHistory(fetched)
+    } catch {
+      // connection dropped — retried on reconnect
+    }
   }, [])
 
   useEffect(() => {
@@ -103,43 +145,61 @@ export default function TemperaturePage() {
     fetchHistory()
   }, [connection, fetchHistory])
 
-  // Live updates from broadcast
+  // Live updates from broadcast; an id not in the table yet gets its card and line here
   useEffect(() => {
     return backend.subscribe((msg) => {
       if (!Array.isArray(msg.logEntry)) return
       const raw = msg.logEntry as RawLogEntry
-      const point = rawToChartPoint(raw)
-      if (!point) return
+      const ts = readingTime(raw)
+      if (ts === null) return
 
-      setCurrent(decodeTemps(raw))
+      const temps = decodeTemps(raw)
+      if (temps.size === 0) return
+      setCurrent((prev) => new Map([...prev, ...temps]))
       setHistory((prev) => {
-        const next = [...prev, point]
-        return next.length > CHART_ENTRIES ? next.slice(-CHART_ENTRIES) : next
+        const next = applyEntry(extendGrid(prev, ts, grid.rate, lastLogged.current, grid.maxGap), ts, temps)
+        lastLogged.current = Math.max(lastLogged.current, ts)
+        return next
       })
     })
-  }, [])
+  }, [grid])
+
+  // Nothing is logged while readings stay inside the deadband; keep the
+  // chart moving by carrying the values forward on the sample grid
+  useEffect(() => {
+    const timer = setInterval(() => {
+      const now = Math.floor(Date.now() / 1000)
+      setHistory((prev) => extendGrid(prev, now, grid.rate, lastLogged.current, grid.maxGap))
+    }, grid.rate * 1000)
+    return () => clearInterval(timer)
+  }, [grid])
+
+  const ids = [...current.keys()].sort((a, b) => a - b)
 
   return (
     <div className="flex h-full flex-col gap-4">
       {/* Sensor cards */}
       <div className="grid grid-cols-2 gap-3 sm:grid-cols-4">
-        {current.map((temp, i) => (
-          <div
-            key={i}
-            className="rounded-lg border-2 bg-card p-3 text-center"
-            style={{ borderColor: SLOT_COLORS[i] }}
-          >
+        {ids.map((id) => {
+          const temp = current.get(id) ?? null
+          return (
             <div
-              className="text-xs font-medium uppercase tracking-wide"
-              style={{ color: SLOT_COLORS[i] }}
+              key={id}
+              className="rounded-lg border-2 bg-card p-3 text-center"
+              style={{ borderColor: sensorColor(id) }}
             >
-              {SLOT_NAMES[i]}
-            </div>
-            <div className="mt-1 text-2xl font-bold tabular-nums">
-              {temp !== null ? `${temp.toFixed(1)}°` : "--.-"}
+              <div
+                className="text-xs font-medium uppercase tracking-wide"
+                style={{ color: sensorColor(id) }}
+              >
+                {sensorName(id)}
+              </div>
+              <div className="mt-1 text-2xl font-bold tabular-nums">
+                {temp !== null ? `${temp.toFixed(1)}°` : "--.-"}
+              </div>
             </div>
-          </div>
-        ))}
+          )
+        })}
       </div>
 
       {/* Chart */}
@@ -167,17 +227,17 @@ export default function TemperaturePage() {
               labelStyle={{ color: "#aaa" }}
             />
             <Legend />
-            {SLOT_NAMES.map((name, i) => (
+            {ids.map((id) => (
               <Line
-                key={i}
-                type="monotone"
-                dataKey={`t${i + 1}`}
-                name={name}
-                stroke={SLOT_COLORS[i]}
+                key={id}
+                type="stepAfter"
+                dataKey={sensorKey(id)}
+                name={sensorName(id)}
+                stroke={sensorColor(id)}
                 strokeWidth={2}
                 dot={false}
                 isAnimationActive={false}
-                hide={current[i] === null}
+                hide={current.get(id) === null}
               />
             ))}
           </LineChart>
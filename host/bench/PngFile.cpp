@@ -0,0 +1,172 @@
+#include "PngFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+static constexpr uint8_t SIGNATURE[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+static constexpr size_t STORED_BLOCK_MAX = 65535;
+
+static uint32_t Crc32(const uint8_t *data, size_t length, uint32_t crc = 0)
+{
+    static uint32_t table[256];
+    if (!table[1])
+    {
+        for (uint32_t n = 0; n < 256; n++)
+        {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[n] = c;
+        }
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++)
+        crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+static uint32_t Adler32(const uint8_t *data, size_t length)
+{
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        a = (a + data[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+static void PutBe32(std::vector<uint8_t> &out, uint32_t v)
+{
+    out.push_back(v >> 24);
+    out.push_back(v >> 16);
+    out.push_back(v >> 8);
+    out.push_back(v);
+}
+
+static uint32_t GetBe32(const uint8_t *p)
+{
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+static void PutChunk(std::vector<uint8_t> &out, const char *type, const std::vector<uint8_t> &data)
+{
+    PutBe32(out, static_cast<uint32_t>(data.size()));
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    PutBe32(out, Crc32(&out[start], out.size() - start));
+}
+
+bool PngFile::Write(const char *path, const uint8_t *rgb, uint32_t width, uint32_t height)
+{
+    // Scanlines, each prefixed with filter type 0
+    size_t stride = width * 3;
+    std::vector<uint8_t> raw;
+    raw.reserve((stride + 1) * height);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        raw.push_back(0);
+        raw.insert(raw.end(), rgb + y * stride, rgb + (y + 1) * stride);
+    }
+
+    // zlib stream of stored blocks
+    std::vector<uint8_t> zlib = {0x78, 0x01};
+    for (size_t pos = 0; pos < raw.size() || pos == 0;)
+    {
+        size_t length = std::min(STORED_BLOCK_MAX, raw.size() - pos);
+        bool last = pos + length == raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(length & 0xff);
+        zlib.push_back(length >> 8);
+        zlib.push_back(~length & 0xff);
+        zlib.push_back((~length >> 8) & 0xff);
+        zlib.insert(zlib.end(), raw.begin() + pos, raw.begin() + pos + length);
+        pos += length;
+        if (last)
+            break;
+    }
+    PutBe32(zlib, Adler32(raw.data(), raw.size()));
+
+    std::vector<uint8_t> header;
+    PutBe32(header, width);
+    PutBe32(header, height);
+    header.insert(header.end(), {8, 2, 0, 0, 0});   // 8-bit RGB, no interlace
+
+    std::vector<uint8_t> file(SIGNATURE, SIGNATURE + sizeof(SIGNATURE));
+    PutChunk(file, "IHDR", header);
+    PutChunk(file, "IDAT", zlib);
+    PutChunk(file, "IEND", {});
+
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return false;
+    bool ok = fwrite(file.data(), 1, file.size(), f) == file.size();
+    return fclose(f) == 0 && ok;
+}
+
+bool PngFile::Read(const char *path, std::vector<uint8_t> &rgb, uint32_t &width, uint32_t &height)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+    std::vector<uint8_t> file;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        file.insert(file.end(), buf, buf + n);
+    fclose(f);
+
+    if (file.size() < sizeof(SIGNATURE) || memcmp(file.data(), SIGNATURE, sizeof(SIGNATURE)) != 0)
+        return false;
+
+    std::vector<uint8_t> zlib;
+    width = height = 0;
+    for (size_t pos = sizeof(SIGNATURE); pos + 12 <= file.size();)
+    {
+        uint32_t length = GetBe32(&file[pos]);
+        if (pos + 12 + length > file.size())
+            return false;
+        const uint8_t *type = &file[pos + 4];
+        const uint8_t *data = &file[pos + 8];
+        if (memcmp(type, "IHDR", 4) == 0)
+        {
+            if (length < 13 || data[8] != 8 || data[9] != 2 || data[12] != 0)
+                return false;
+            width = GetBe32(data);
+            height = GetBe32(data + 4);
+        }
+        else if (memcmp(type, "IDAT", 4) == 0)
+            zlib.insert(zlib.end(), data, data + length);
+        pos += 12 + length;
+    }
+
+    // Stored blocks only
+    size_t stride = width * 3;
+    std::vector<uint8_t> raw;
+    for (size_t pos = 2; pos + 5 <= zlib.size();)
+    {
+        uint8_t flags = zlib[pos];
+        if ((flags >> 1) != 0)
+            return false;
+        size_t length = zlib[pos + 1] | zlib[pos + 2] << 8;
+        pos += 5;
+        if (pos + length > zlib.size())
+            return false;
+        raw.insert(raw.end(), zlib.begin() + pos, zlib.begin() + pos + length);
+        pos += length;
+        if (flags & 1)
+            break;
+    }
+    if (width == 0 || raw.size() != (stride + 1) * height)
+        return false;
+
+    rgb.resize(stride * height);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        if (raw[y * (stride + 1)] != 0)
+            return false;
+        memcpy(&rgb[y * stride], &raw[y * (stride + 1) + 1], stride);
+    }
+    return true;
+}
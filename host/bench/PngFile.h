@@ -0,0 +1,12 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/// Minimal PNG I/O for frame dumps: 8-bit RGB, no filtering, stored
+/// (uncompressed) deflate blocks. Read only accepts files in that form, i.e.
+/// ones written by Write.
+namespace PngFile
+{
+    bool Write(const char *path, const uint8_t *rgb, uint32_t width, uint32_t height);
+    bool Read(const char *path, std::vector<uint8_t> &rgb, uint32_t &width, uint32_t &height);
+}
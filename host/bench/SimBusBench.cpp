@@ -0,0 +1,306 @@
+// Drives SimOneWireBus through the DS18B20 protocol the way the bus tasks do,
+// checks what comes back and times it.
+//
+//   thermy_sim_bench [--devices N] [--cycles N] [--seed N]
+//
+//   --devices N      largest bus the search is run on (default 200)
+//   --cycles N       read cycles for the fault model check (default 2000)
+//   --seed N         simulator and ROM code seed (default 1)
+//
+// Checks, in order:
+//  - Search ROM finds exactly the connected devices, for 1 to N on one bus
+//  - Read Scratchpad returns the power-on 85 °C until Convert T has taken as
+//    long as the configured resolution needs, then the temperature at that
+//    resolution
+//  - Dropouts and CRC errors come out at the configured rates
+// Exits 1 on any failure. Time is virtual (setClock), so conversions cost no
+// wall time; the timings are host CPU per operation.
+
+#include "sim_onewire.h"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdarg>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <set>
+#include <vector>
+
+class SimBusBench
+{
+    static constexpr uint8_t CMD_SKIP_ROM = 0xCC;
+    static constexpr uint8_t CMD_MATCH_ROM = 0x55;
+    static constexpr uint8_t CMD_CONVERT_T = 0x44;
+    static constexpr uint8_t CMD_READ_SCRATCHPAD = 0xBE;
+    static constexpr uint8_t CMD_WRITE_SCRATCHPAD = 0x4E;
+    static constexpr int16_t POWER_ON_RAW = 0x0550;        // 85 °C
+    static constexpr int64_t MAX_CONVERSION_US = 750000;
+
+public:
+    struct Options
+    {
+        size_t devices = 200;
+        uint32_t cycles = 2000;
+        uint32_t seed = 1;
+    };
+
+    explicit SimBusBench(const Options &options) : options(options), rng(options.seed) {}
+
+    int Run();
+
+private:
+    enum class Read { Ok, Missing, CrcError };
+
+    Options options;
+    std::mt19937_64 rng;
+    int64_t clockUs = 0;
+    uint32_t failures = 0;
+
+    SimOneWireBus MakeBus(size_t devices, std::vector<uint64_t> &roms);
+    void Convert(SimOneWireBus &bus);
+    void SetResolution(SimOneWireBus &bus, uint64_t rom, int bits);
+    Read ReadScratchpad(SimOneWireBus &bus, uint64_t rom, int16_t &raw);
+    void Check(bool ok, const char *what, ...) __attribute__((format(printf, 3, 4)));
+
+    void RunSearch();
+    void RunConversion();
+    void RunFaults();
+};
+
+// ── Bus operations ───────────────────────────────────────────
+
+SimOneWireBus SimBusBench::MakeBus(size_t devices, std::vector<uint64_t> &roms)
+{
+    SimOneWireBus bus(options.seed);
+    bus.setClock([this]() { return clockUs; });
+
+    // Random serials make the search tree as irregular as a real bus
+    std::set<uint64_t> serials;
+    while (serials.size() < devices)
+        serials.insert(rng() & 0xFFFFFFFFFFFFull);
+
+    roms.clear();
+    for (uint64_t serial : serials)
+    {
+        SimDevice device;
+        device.rom = SimOneWireBus::makeRom(serial);
+        bus.addDevice(device);
+        roms.push_back(device.rom);
+    }
+    return bus;
+}
+
+void SimBusBench::Convert(SimOneWireBus &bus)
+{
+    const uint8_t cmd[] = {CMD_SKIP_ROM, CMD_CONVERT_T};
+    bus.reset();
+    bus.writeBytes(cmd, sizeof(cmd));
+}
+
+void SimBusBench::SetResolution(SimOneWireBus &bus, uint64_t rom, int bits)
+{
+    uint8_t cmd[1 + 8 + 1 + 3] = {CMD_MATCH_ROM};
+    memcpy(&cmd[1], &rom, 8);
+    cmd[9] = CMD_WRITE_SCRATCHPAD;
+    cmd[10] = 0x4B;                                         // TH, TL: power-on values
+    cmd[11] = 0x46;
+    cmd[12] = static_cast<uint8_t>(((bits - 9) << 5) | 0x1F);
+    bus.reset();
+    bus.writeBytes(cmd, sizeof(cmd));
+}
+
+SimBusBench::Read SimBusBench::ReadScratchpad(SimOneWireBus &bus, uint64_t rom, int16_t &raw)
+{
+    uint8_t cmd[1 + 8 + 1] = {CMD_MATCH_ROM};
+    memcpy(&cmd[1], &rom, 8);
+    cmd[9] = CMD_READ_SCRATCHPAD;
+    if (!bus.reset())
+        return Read::Missing;
+    bus.writeBytes(cmd, sizeof(cmd));
+
+    uint8_t data[9];
+    bus.readBytes(data, sizeof(data));
+
+    // Nobody driving the line reads as all ones
+    if (std::all_of(data, data + sizeof(data), [](uint8_t b) { return b == 0xFF; }))
+        return Read::Missing;
+    if (IOneWireBus::crc8(data, 8) != data[8])
+        return Read::CrcError;
+    raw = static_cast<int16_t>(data[0] | (data[1] << 8));
+    return Read::Ok;
+}
+
+void SimBusBench::Check(bool ok, const char *what, ...)
+{
+    if (ok)
+        return;
+    failures++;
+    va_list args;
+    va_start(args, what);
+    printf("  FAIL: ");
+    vprintf(what, args);
+    printf("\n");
+    va_end(args);
+}
+
+// ── Checks ───────────────────────────────────────────────────
+
+void SimBusBench::RunSearch()
+{
+    printf("%-8s %10s %12s\n", "devices", "found", "search us");
+
+    std::vector<size_t> sizes = {1, 2, 8, 64};
+    if (options.devices > 64)
+        sizes.push_back(options.devices);
+    sizes.erase(std::remove_if(sizes.begin(), sizes.end(), [&](size_t n) { return n > options.devices; }), sizes.end());
+
+    for (size_t n : sizes)
+    {
+        std::vector<uint64_t> roms;
+        SimOneWireBus bus = MakeBus(n, roms);
+
+        std::vector<uint64_t> found(n + 1);
+        size_t count = 0;
+        auto start = std::chrono::steady_clock::now();
+        bool ok = bus.search(found.data(), found.size(), count);
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        printf("%-8zu %10zu %12.0f\n", n, count, us);
+
+        found.resize(count);
+        std::sort(found.begin(), found.end());
+        std::sort(roms.begin(), roms.end());
+        Check(ok && found == roms, "search on %zu devices found %zu", n, count);
+
+        // A disconnected device drops out of the next search
+        bus.device(0).connected = false;
+        found.assign(n + 1, 0);
+        ok = bus.search(found.data(), found.size(), count);
+        Check(ok && count == n - 1, "search with one of %zu disconnected found %zu", n, count);
+    }
+}
+
+void SimBusBench::RunConversion()
+{
+    std::vector<uint64_t> roms;
+    SimOneWireBus bus = MakeBus(16, roms);
+    for (size_t i = 0; i < roms.size(); i++)
+    {
+        bus.device(i).temperatureC = -10.0f + i * 7.3f;
+        SetResolution(bus, roms[i], 9 + i % 4);
+    }
+
+    // Before and right after Convert T: the power-on value
+    int16_t raw = 0;
+    for (size_t i = 0; i < roms.size(); i++)
+        Check(ReadScratchpad(bus, roms[i], raw) == Read::Ok && raw == POWER_ON_RAW,
+              "device %zu read 0x%04x before any conversion", i, (unsigned)(uint16_t)raw);
+    Convert(bus);
+    int64_t convertUs = clockUs;
+
+    // Each resolution is ready at 93.75 ms << (bits - 9), not before
+    for (int bits = 9; bits <= 12; bits++)
+    {
+        clockUs = convertUs + (93750ll << (bits - 9)) - 1;
+        for (size_t i = bits - 9; i < roms.size(); i += 4)
+        {
+            Check(ReadScratchpad(bus, roms[i], raw) == Read::Ok && raw == POWER_ON_RAW,
+                  "%d-bit device %zu ready early", bits, i);
+        }
+        clockUs += 1;
+        for (size_t i = bits - 9; i < roms.size(); i += 4)
+        {
+            // Bits below the resolution read as zero
+            int16_t expected = static_cast<int16_t>(std::lround(bus.device(i).temperatureC * 16.0f));
+            expected = static_cast<int16_t>(expected & ~((1 << (12 - bits)) - 1));
+            Check(ReadScratchpad(bus, roms[i], raw) == Read::Ok && raw == expected,
+                  "%d-bit device %zu read %d/16 °C, expected %d/16", bits, i, raw, expected);
+        }
+    }
+    printf("conversion: 16 devices at 9-12 bit checked\n");
+}
+
+void SimBusBench::RunFaults()
+{
+    constexpr float dropoutRate = 0.05f;
+    constexpr float crcErrorRate = 0.02f;
+
+    std::vector<uint64_t> roms;
+    SimOneWireBus bus = MakeBus(8, roms);
+    for (size_t i = 0; i < roms.size(); i++)
+    {
+        bus.device(i).temperatureC = 21.5f;
+        bus.device(i).noiseC = 0.1f;
+        bus.device(i).dropoutRate = dropoutRate;
+        bus.device(i).crcErrorRate = crcErrorRate;
+    }
+
+    uint64_t reads = 0, missing = 0, crcErrors = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t c = 0; c < options.cycles; c++)
+    {
+        Convert(bus);
+        clockUs += MAX_CONVERSION_US;
+        for (uint64_t rom : roms)
+        {
+            int16_t raw;
+            Read result = ReadScratchpad(bus, rom, raw);
+            reads++;
+            if (result == Read::Missing) missing++;
+            else if (result == Read::CrcError) crcErrors++;
+        }
+    }
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    // A CRC error can only hit a device that answered the reset
+    double expectMissing = dropoutRate;
+    double expectCrc = (1.0 - dropoutRate) * crcErrorRate;
+    double gotMissing = double(missing) / reads;
+    double gotCrc = double(crcErrors) / reads;
+    auto within = [&](double got, double p) { return std::fabs(got - p) <= 4.0 * std::sqrt(p * (1 - p) / reads); };
+
+    printf("faults: %" PRIu64 " reads, %.2f%% missing (expected %.2f%%), %.2f%% CRC errors (expected %.2f%%), "
+           "%.1f us per cycle of %zu\n",
+           reads, gotMissing * 100, expectMissing * 100, gotCrc * 100, expectCrc * 100,
+           us / options.cycles, roms.size());
+    Check(within(gotMissing, expectMissing), "dropout rate %.4f, expected %.4f", gotMissing, expectMissing);
+    Check(within(gotCrc, expectCrc), "CRC error rate %.4f, expected %.4f", gotCrc, expectCrc);
+}
+
+// ── Run ──────────────────────────────────────────────────────
+
+int SimBusBench::Run()
+{
+    RunSearch();
+    printf("\n");
+    RunConversion();
+    RunFaults();
+
+    printf("\n%s: %" PRIu32 " checks failed\n", failures ? "FAIL" : "OK", failures);
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    SimBusBench::Options options;
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--devices") == 0 && hasValue)
+            options.devices = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--cycles") == 0 && hasValue)
+            options.cycles = static_cast<uint32_t>(std::max(1, atoi(argv[++i])));
+        else if (strcmp(argv[i], "--seed") == 0 && hasValue)
+            options.seed = static_cast<uint32_t>(atoi(argv[++i]));
+        else
+        {
+            fprintf(stderr, "usage: %s [--devices N] [--cycles N] [--seed N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    SimBusBench bench(options);
+    return bench.Run();
+}
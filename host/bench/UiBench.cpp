@@ -0,0 +1,299 @@
+// Renders the display pages headless and reports what each navigation costs.
+//
+//   thermy_ui_bench [--frames DIR] [--expect DIR] [--lines N] [--steady SECONDS]
+//
+//   --frames DIR     write every step's settled frame as DIR/NN-page.png
+//   --expect DIR     compare every frame with DIR/NN-page.png; exit 1 on a diff
+//   --lines N        draw buffer height (default BoardConfig::DISPLAY_BUFFER_LINES)
+//   --steady S       seconds of home page readings to time afterwards (default 60)
+//
+// Time is virtual (HostRuntime.h): LVGL timers, animations and the clock on
+// the pages only advance when the benchmark says so, so the same build
+// always renders the same pixels. Render times are measured on the host CPU
+// and are only meaningful relative to each other.
+
+#include "DisplayManager.h"
+#include "HistoryCache/HistoryCache.h"
+#include "NetworkManager/NetworkManager.h"
+#include "PngFile.h"
+#include "RollingStats/RollingStats.h"
+#include "SensorManager/SensorManager.h"
+#include "SettingsManager/SettingsManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+class BenchContext : public ServiceProvider
+{
+public:
+    HistoryCache history;
+    NetworkManager network;
+    RollingStats rollingStats;
+    SensorManager sensors;
+    SettingsManager settings;
+
+    HistoryCache &getHistoryCache() override { return history; }
+    NetworkManager &getNetworkManager() override { return network; }
+    RollingStats &getRollingStats() override { return rollingStats; }
+    SensorManager &getSensorManager() override { return sensors; }
+    SettingsManager &getSettingsManager() override { return settings; }
+};
+
+/// Drives DisplayManager the way its task would, one step at a time.
+class UiBench
+{
+    static constexpr int64_t FRAME_US = LV_DISP_DEF_REFR_PERIOD * 1000;
+    static constexpr int SETTLE_FRAMES = 30;        // let animations and scrollbars finish
+
+public:
+    struct Options
+    {
+        const char *framesDir = nullptr;
+        const char *expectDir = nullptr;
+        uint32_t steadySeconds = 60;
+    };
+
+    UiBench(BenchContext &context, DisplayManager &displayManager, const Options &options)
+        : ctx(context), dm(displayManager), options(options) {}
+
+    int Run();
+
+private:
+    struct Step
+    {
+        double renderUs;            // NavigateTo and the first frame
+        uint64_t pixels;
+        uint32_t flushes;
+        uint64_t allocs;
+        int64_t bytes;              // net change of LVGL heap in use
+        bool created;
+    };
+
+    BenchContext &ctx;
+    DisplayManager &dm;
+    Options options;
+    uint32_t frameIndex = 0;
+    uint32_t mismatches = 0;
+
+    void Publish();
+    void Settle();
+    Step Navigate(const char *page);
+    void CheckFrame(const char *name);
+    const char *ActivePageName();
+};
+
+// ── Steps ────────────────────────────────────────────────────
+
+void UiBench::Publish()
+{
+    ctx.sensors.Publish(static_cast<uint32_t>(time(nullptr)));
+    if (dm.activePage)
+        dm.activePage->OnReadings(ctx.sensors.GetSnapshot());
+}
+
+void UiBench::Settle()
+{
+    for (int i = 0; i < SETTLE_FRAMES; i++)
+    {
+        HostClockAdvanceUs(FRAME_US);
+        lv_timer_handler();
+    }
+    lv_refr_now(dm.display.GetLvglDisplay());
+}
+
+UiBench::Step UiBench::Navigate(const char *page)
+{
+    auto counters = dm.display.GetCounters();
+    auto alloc = HostAllocGetStats();
+    uint32_t created = dm.GetStats().pagesCreated;
+
+    auto start = std::chrono::steady_clock::now();
+    dm.NavigateTo(page);
+    lv_refr_now(dm.display.GetLvglDisplay());
+    auto end = std::chrono::steady_clock::now();
+    dm.OnNavigateFrame();
+
+    auto countersAfter = dm.display.GetCounters();
+    auto allocAfter = HostAllocGetStats();
+    return {
+        std::chrono::duration<double, std::micro>(end - start).count(),
+        countersAfter.pixelsFlushed - counters.pixelsFlushed,
+        countersAfter.flushes - counters.flushes,
+        allocAfter.allocs - alloc.allocs,
+        allocAfter.bytesInUse - alloc.bytesInUse,
+        dm.GetStats().pagesCreated != created,
+    };
+}
+
+const char *UiBench::ActivePageName()
+{
+    static const char *names[] = {"home", "settings", "wifi", "sensors", "graph", "system", "history"};
+    for (size_t i = 0; i < DisplayManager::PAGE_COUNT; i++)
+        if (dm.pages[i] == dm.activePage)
+            return names[i];
+    return "none";
+}
+
+// ── Frames ───────────────────────────────────────────────────
+
+void UiBench::CheckFrame(const char *name)
+{
+    if (!options.framesDir && !options.expectDir)
+        return;
+
+    constexpr uint32_t width = Display_WT32SC01::LCD_HRES;
+    constexpr uint32_t height = Display_WT32SC01::LCD_VRES;
+    const lv_color_t *fb = dm.display.GetFramebuffer();
+    std::vector<uint8_t> rgb(width * height * 3);
+    for (uint32_t i = 0; i < width * height; i++)
+    {
+        uint32_t c = lv_color_to32(fb[i]);
+        rgb[i * 3 + 0] = (c >> 16) & 0xff;
+        rgb[i * 3 + 1] = (c >> 8) & 0xff;
+        rgb[i * 3 + 2] = c & 0xff;
+    }
+
+    char file[64];
+    snprintf(file, sizeof(file), "%02" PRIu32 "-%s.png", frameIndex++, name);
+
+    if (options.framesDir)
+    {
+        std::string path = std::string(options.framesDir) + "/" + file;
+        if (!PngFile::Write(path.c_str(), rgb.data(), width, height))
+            fprintf(stderr, "Cannot write %s\n", path.c_str());
+    }
+
+    if (options.expectDir)
+    {
+        std::string path = std::string(options.expectDir) + "/" + file;
+        std::vector<uint8_t> expected;
+        uint32_t w, h;
+        if (!PngFile::Read(path.c_str(), expected, w, h) || w != width || h != height)
+        {
+            printf("  %-24s cannot read reference\n", file);
+            mismatches++;
+            return;
+        }
+        uint32_t diff = 0;
+        for (uint32_t i = 0; i < width * height; i++)
+            if (memcmp(&rgb[i * 3], &expected[i * 3], 3) != 0)
+                diff++;
+        if (diff)
+        {
+            printf("  %-24s %" PRIu32 " pixels differ\n", file, diff);
+            mismatches++;
+        }
+    }
+}
+
+// ── Run ──────────────────────────────────────────────────────
+
+int UiBench::Run()
+{
+    if (options.framesDir)
+        mkdir(options.framesDir, 0755);
+
+    dm.Init();
+    Publish();
+
+    // Every page once, then back through the menu and a second round trip,
+    // which only unhides the pages built the first time
+    static const char *sequence[] = {
+        "home", "settings", "wifi", "back", "sensors", "back", "graph", "back",
+        "system", "back", "back", "history", "back", "settings", "wifi", "home",
+    };
+
+    printf("%-10s %-8s %10s %9s %8s %8s %10s\n",
+           "step", "page", "render us", "pixels", "flushes", "allocs", "heap B");
+    for (const char *page : sequence)
+    {
+        Step step = Navigate(page);
+        const char *name = ActivePageName();
+        printf("%-10s %-8s %10.0f %9" PRIu64 " %8" PRIu32 " %8" PRIu64 " %+10" PRId64 "%s\n",
+               page, name, step.renderUs, step.pixels, step.flushes, step.allocs, step.bytes,
+               step.created ? "  (created)" : "");
+        Settle();
+        CheckFrame(name);
+    }
+
+    // Steady state: one reading and one Update() per second on the home page
+    if (options.steadySeconds)
+    {
+        Navigate("home");
+        Settle();
+
+        double totalUs = 0, maxUs = 0;
+        auto counters = dm.display.GetCounters();
+        auto alloc = HostAllocGetStats();
+        for (uint32_t s = 0; s < options.steadySeconds; s++)
+        {
+            HostClockAdvanceUs(1000000);
+            auto start = std::chrono::steady_clock::now();
+            Publish();
+            dm.activePage->Update();
+            lv_timer_handler();
+            lv_refr_now(dm.display.GetLvglDisplay());
+            double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            totalUs += us;
+            maxUs = std::max(maxUs, us);
+        }
+        auto countersAfter = dm.display.GetCounters();
+        auto allocAfter = HostAllocGetStats();
+        printf("\nhome, %" PRIu32 " readings: %.0f us/frame (max %.0f), %" PRIu64 " pixels/frame, "
+               "%.1f allocs/frame, heap %+" PRId64 " B\n",
+               options.steadySeconds, totalUs / options.steadySeconds, maxUs,
+               (countersAfter.pixelsFlushed - counters.pixelsFlushed) / options.steadySeconds,
+               double(allocAfter.allocs - alloc.allocs) / options.steadySeconds,
+               allocAfter.bytesInUse - alloc.bytesInUse);
+        CheckFrame("home-steady");
+    }
+
+    auto stats = dm.GetStats();
+    auto alloc = HostAllocGetStats();
+    printf("\npages created %" PRIu32 ", reused %" PRIu32 ", evicted %" PRIu32
+           "; LVGL heap peak %" PRId64 " B, in use %" PRId64 " B; history queries %" PRIu32 "\n",
+           stats.pagesCreated, stats.pagesReused, stats.pagesEvicted,
+           alloc.peakBytes, alloc.bytesInUse, ctx.history.queries);
+
+    if (options.expectDir)
+        printf("%s: %" PRIu32 " of %" PRIu32 " frames differ\n",
+               mismatches ? "FAIL" : "OK", mismatches, frameIndex);
+    return mismatches ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    UiBench::Options options;
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--frames") == 0 && hasValue)
+            options.framesDir = argv[++i];
+        else if (strcmp(argv[i], "--expect") == 0 && hasValue)
+            options.expectDir = argv[++i];
+        else if (strcmp(argv[i], "--lines") == 0 && hasValue)
+            Display_WT32SC01::bufferLinesOverride = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--steady") == 0 && hasValue)
+            options.steadySeconds = static_cast<uint32_t>(atoi(argv[++i]));
+        else
+        {
+            fprintf(stderr, "usage: %s [--frames DIR] [--expect DIR] [--lines N] [--steady SECONDS]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    // Page clocks are rendered in local time
+    setenv("TZ", "UTC0", 1);
+    tzset();
+
+    static BenchContext ctx;
+    static DisplayManager displayManager(ctx);
+    UiBench bench(ctx, displayManager, options);
+    return bench.Run();
+}
@@ -0,0 +1,47 @@
+/**
+ * LVGL configuration for the host build. Mirrors the firmware's Kconfig
+ * (sdkconfig.defaults) except:
+ *  - LV_COLOR_16_SWAP is off; swapping only matters for the SPI panel
+ *  - memory comes from a counting allocator (HostRuntime.h)
+ *  - the tick is the benchmark's virtual clock, so renders are reproducible
+ */
+#if 1
+
+#ifndef LV_CONF_H
+#define LV_CONF_H
+
+#include <stdint.h>
+
+#define LV_COLOR_DEPTH 16
+#define LV_COLOR_16_SWAP 0
+
+#define LV_MEM_CUSTOM 1
+#define LV_MEM_CUSTOM_INCLUDE "HostRuntime.h"
+#define LV_MEM_CUSTOM_ALLOC HostMalloc
+#define LV_MEM_CUSTOM_FREE HostFree
+#define LV_MEM_CUSTOM_REALLOC HostRealloc
+
+#define LV_TICK_CUSTOM 1
+#define LV_TICK_CUSTOM_INCLUDE "HostRuntime.h"
+#define LV_TICK_CUSTOM_SYS_TIME_EXPR (HostClockMs())
+
+#define LV_DISP_DEF_REFR_PERIOD 30
+#define LV_INDEV_DEF_READ_PERIOD 30
+
+#define LV_USE_LOG 1
+#define LV_LOG_LEVEL LV_LOG_LEVEL_WARN
+#define LV_LOG_PRINTF 1
+
+#define LV_FONT_MONTSERRAT_10 1
+#define LV_FONT_MONTSERRAT_14 1
+#define LV_FONT_MONTSERRAT_20 1
+#define LV_FONT_MONTSERRAT_28 1
+#define LV_FONT_DEFAULT &lv_font_montserrat_14
+
+#define LV_USE_SNAPSHOT 1
+
+#define LV_BUILD_EXAMPLES 0
+
+#endif /*LV_CONF_H*/
+
+#endif /*Enable content*/
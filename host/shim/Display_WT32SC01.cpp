@@ -0,0 +1,98 @@
+#include "Display_WT32SC01.h"
+#include "BoardConfig.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+Display_WT32SC01::~Display_WT32SC01()
+{
+    free(buf1);
+    free(buf2);
+    free(framebuffer);
+}
+
+void Display_WT32SC01::Init()
+{
+    bufferLines = std::clamp(bufferLinesOverride > 0 ? bufferLinesOverride : BoardConfig::DISPLAY_BUFFER_LINES, 1, LCD_VRES);
+    size_t bytes = LCD_HRES * bufferLines * sizeof(lv_color_t);
+    buf1 = static_cast<lv_color_t *>(malloc(bytes));
+    buf2 = static_cast<lv_color_t *>(malloc(bytes));
+    framebuffer = static_cast<lv_color_t *>(calloc(LCD_HRES * LCD_VRES, sizeof(lv_color_t)));
+    assert(buf1 && buf2 && framebuffer);
+    lv_disp_draw_buf_init(&drawBuf, buf1, buf2, LCD_HRES * bufferLines);
+
+    lv_disp_drv_init(&dispDrv);
+    dispDrv.flush_cb = LvglFlushCb;
+    dispDrv.monitor_cb = LvglMonitorCb;
+    dispDrv.draw_buf = &drawBuf;
+    dispDrv.hor_res = LCD_HRES;
+    dispDrv.ver_res = LCD_VRES;
+    dispDrv.user_data = this;
+    disp = lv_disp_drv_register(&dispDrv);
+
+    static lv_indev_drv_t indevDrv;
+    lv_indev_drv_init(&indevDrv);
+    indevDrv.type = LV_INDEV_TYPE_POINTER;
+    indevDrv.read_cb = LvglTouchCb;
+    indevDrv.user_data = this;
+    inputDev = lv_indev_drv_register(&indevDrv);
+
+    ESP_LOGI(TAG, "Host framebuffer registered (2 x %d lines)", bufferLines);
+}
+
+void Display_WT32SC01::IgnoreUntilRelease()
+{
+    if (inputDev)
+        lv_indev_wait_release(inputDev);
+}
+
+uint8_t Display_WT32SC01::GetTouchPoints(lv_point_t *out) const
+{
+    for (uint8_t i = 0; i < touchCount; i++)
+        out[i] = touchPoints[i];
+    return touchCount;
+}
+
+void Display_WT32SC01::InjectTouch(const lv_point_t *points, uint8_t count)
+{
+    touchCount = std::min(count, MAX_TOUCH_POINTS);
+    for (uint8_t i = 0; i < touchCount; i++)
+        touchPoints[i] = points[i];
+    counters.touchIrqs++;
+    if (touchWake)
+        touchWake(touchWakeCtx);
+}
+
+void Display_WT32SC01::LvglTouchCb(lv_indev_drv_t *drv, lv_indev_data_t *data)
+{
+    auto *self = static_cast<Display_WT32SC01 *>(drv->user_data);
+    if (self->touchCount == 0)
+    {
+        data->state = LV_INDEV_STATE_RELEASED;
+        return;
+    }
+    self->counters.touchReads++;
+    data->point = self->touchPoints[0];
+    data->state = LV_INDEV_STATE_PRESSED;
+}
+
+void Display_WT32SC01::LvglFlushCb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    auto *self = static_cast<Display_WT32SC01 *>(drv->user_data);
+    int32_t width = lv_area_get_width(area);
+    for (int32_t y = area->y1; y <= area->y2; y++)
+    {
+        memcpy(&self->framebuffer[y * LCD_HRES + area->x1], color_p, width * sizeof(lv_color_t));
+        color_p += width;
+    }
+    self->counters.pixelsFlushed += lv_area_get_size(area);
+    self->counters.flushes++;
+    lv_disp_flush_ready(drv);
+}
+
+void Display_WT32SC01::LvglMonitorCb(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    auto *self = static_cast<Display_WT32SC01 *>(drv->user_data);
+    self->counters.frames++;
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include "lvgl.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+
+/// Host stand-in for the WT32-SC01 panel: LVGL renders through the same
+/// partial draw buffers into a 480x320 framebuffer in memory, and touches
+/// are injected by the caller instead of read over I2C.
+class Display_WT32SC01
+{
+    inline static constexpr const char *TAG = "Display_WT32SC01";
+
+public:
+    static constexpr int LCD_HRES = 480;
+    static constexpr int LCD_VRES = 320;
+
+    Display_WT32SC01() = default;
+    ~Display_WT32SC01();
+
+    /// Running totals since Init; the host adds what the panel would cost.
+    struct Counters
+    {
+        uint32_t frames;        // completed refreshes
+        uint64_t blockedUs;     // always 0: the framebuffer copy is synchronous
+        uint32_t touchIrqs;     // injected touch changes
+        uint32_t touchReads;    // indev reads that returned a point
+        uint64_t pixelsFlushed; // pixels passed to flush_cb
+        uint32_t flushes;       // flush_cb calls (SPI transfers on the panel)
+    };
+
+    using WakeFunc = void (*)(void *ctx);
+
+    /// Draw buffer height in lines for displays initialised after this is
+    /// set; 0 uses BoardConfig::DISPLAY_BUFFER_LINES.
+    static inline int bufferLinesOverride = 0;
+
+    void Init();
+    void SetBrightness(uint8_t percent) { brightness = percent; }
+    void SetTouchWakeHandler(WakeFunc func, void *ctx) { touchWake = func; touchWakeCtx = ctx; }
+    void ServiceTouch() {}
+    void IgnoreUntilRelease();
+    lv_disp_t* GetLvglDisplay() const { return disp; }
+    Counters GetCounters() const { return counters; }
+    int GetBufferLines() const { return bufferLines; }
+    bool IsBufferInPsram() const { return false; }
+
+    static constexpr uint8_t MAX_TOUCH_POINTS = 2;
+    uint8_t GetTouchPoints(lv_point_t *out) const;
+
+    // ── Host only ────────────────────────────────────────────
+
+    /// Press (count 1-2) or release (count 0) the panel.
+    void InjectTouch(const lv_point_t *points, uint8_t count);
+    /// LCD_HRES * LCD_VRES pixels as last flushed.
+    const lv_color_t *GetFramebuffer() const { return framebuffer; }
+    uint8_t GetBrightness() const { return brightness; }
+
+private:
+    lv_disp_draw_buf_t drawBuf;
+    lv_color_t *buf1 = nullptr;
+    lv_color_t *buf2 = nullptr;
+    lv_color_t *framebuffer = nullptr;
+    lv_disp_drv_t dispDrv;
+    lv_disp_t *disp = nullptr;
+    int bufferLines = 0;
+    uint8_t brightness = 100;
+    Counters counters = {};
+
+    lv_indev_t *inputDev = nullptr;
+    lv_point_t touchPoints[MAX_TOUCH_POINTS] = {};
+    uint8_t touchCount = 0;
+    WakeFunc touchWake = nullptr;
+    void *touchWakeCtx = nullptr;
+
+    static void LvglFlushCb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+    static void LvglMonitorCb(lv_disp_drv_t *drv, uint32_t time, uint32_t px);
+    static void LvglTouchCb(lv_indev_drv_t *drv, lv_indev_data_t *data);
+};
@@ -0,0 +1,70 @@
+#include "HostRuntime.h"
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+static int64_t clockUs = 0;
+static HostAllocStats allocStats = {};
+
+uint32_t HostClockMs(void) { return static_cast<uint32_t>(clockUs / 1000); }
+int64_t HostClockUs(void) { return clockUs; }
+void HostClockAdvanceUs(int64_t us) { clockUs += us; }
+
+// Linked with -Wl,--wrap=time, so DateTime::Now() follows the virtual clock
+extern "C" time_t __wrap_time(time_t *out)
+{
+    time_t now = static_cast<time_t>(HOST_EPOCH_UTC + clockUs / 1000000);
+    if (out)
+        *out = now;
+    return now;
+}
+
+// ── Allocator ────────────────────────────────────────────────
+// Each block carries its size in front so frees can be accounted.
+
+static constexpr size_t HEADER = 16;
+
+void *HostMalloc(size_t size)
+{
+    auto *raw = static_cast<uint8_t *>(malloc(size + HEADER));
+    if (!raw)
+        return nullptr;
+    memcpy(raw, &size, sizeof(size));
+    allocStats.allocs++;
+    allocStats.bytesInUse += static_cast<int64_t>(size);
+    if (allocStats.bytesInUse > allocStats.peakBytes)
+        allocStats.peakBytes = allocStats.bytesInUse;
+    return raw + HEADER;
+}
+
+void HostFree(void *ptr)
+{
+    if (!ptr)
+        return;
+    auto *raw = static_cast<uint8_t *>(ptr) - HEADER;
+    size_t size;
+    memcpy(&size, raw, sizeof(size));
+    allocStats.frees++;
+    allocStats.bytesInUse -= static_cast<int64_t>(size);
+    free(raw);
+}
+
+void *HostRealloc(void *ptr, size_t size)
+{
+    if (!ptr)
+        return HostMalloc(size);
+    auto *raw = static_cast<uint8_t *>(ptr) - HEADER;
+    size_t oldSize;
+    memcpy(&oldSize, raw, sizeof(oldSize));
+    auto *grown = static_cast<uint8_t *>(realloc(raw, size + HEADER));
+    if (!grown)
+        return nullptr;
+    memcpy(grown, &size, sizeof(size));
+    allocStats.reallocs++;
+    allocStats.bytesInUse += static_cast<int64_t>(size) - static_cast<int64_t>(oldSize);
+    if (allocStats.bytesInUse > allocStats.peakBytes)
+        allocStats.peakBytes = allocStats.bytesInUse;
+    return grown + HEADER;
+}
+
+HostAllocStats HostAllocGetStats(void) { return allocStats; }
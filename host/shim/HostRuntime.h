@@ -0,0 +1,38 @@
+#pragma once
+/// Host build runtime: the virtual clock and the counting allocator LVGL is
+/// configured with (lv_conf.h), shared with the ESP-IDF shims.
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Wall clock at virtual time 0: 2024-06-01 12:00:00 UTC. time() is wrapped
+/// at link time to read the virtual clock from here.
+#define HOST_EPOCH_UTC 1717243200u
+
+/// Virtual time since start, advanced only by the benchmark, so rendering
+/// and timers are reproducible.
+uint32_t HostClockMs(void);
+int64_t HostClockUs(void);
+void HostClockAdvanceUs(int64_t us);
+
+/// Allocation counters for everything LVGL allocates.
+typedef struct
+{
+    uint64_t allocs;
+    uint64_t frees;
+    uint64_t reallocs;
+    int64_t bytesInUse;
+    int64_t peakBytes;
+} HostAllocStats;
+
+void *HostMalloc(size_t size);
+void *HostRealloc(void *ptr, size_t size);
+void HostFree(void *ptr);
+HostAllocStats HostAllocGetStats(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,20 @@
+#pragma once
+// Host shim: only the services the display code asks for. The benchmark
+// implements it over the stub managers.
+
+class DisplayManager;
+class HistoryCache;
+class NetworkManager;
+class RollingStats;
+class SensorManager;
+class SettingsManager;
+
+class ServiceProvider
+{
+public:
+    virtual HistoryCache& getHistoryCache() = 0;
+    virtual NetworkManager& getNetworkManager() = 0;
+    virtual RollingStats& getRollingStats() = 0;
+    virtual SensorManager& getSensorManager() = 0;
+    virtual SettingsManager& getSettingsManager() = 0;
+};
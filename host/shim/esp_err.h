@@ -0,0 +1,12 @@
+#pragma once
+// Host shim: esp_err_t and ESP_ERROR_CHECK.
+#include <cstdio>
+#include <cstdlib>
+
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+
+inline const char *esp_err_to_name(esp_err_t err) { return err == ESP_OK ? "ESP_OK" : "ESP_FAIL"; }
+
+#define ESP_ERROR_CHECK(x) do { esp_err_t err_ = (x); if (err_ != ESP_OK) { fprintf(stderr, "ESP_ERROR_CHECK failed: %s\n", #x); abort(); } } while (0)
@@ -0,0 +1,6 @@
+#pragma once
+// Host shim: esp_timer reads the virtual clock.
+#include "HostRuntime.h"
+#include "esp_err.h"
+
+inline int64_t esp_timer_get_time() { return HostClockUs(); }
@@ -0,0 +1,19 @@
+#pragma once
+// Host shim: the FreeRTOS types and macros the display code uses. Ticks are
+// milliseconds of the virtual clock.
+#include "HostRuntime.h"
+#include <cstdint>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS 1
+#define portMAX_DELAY 0xFFFFFFFFu
+#define configTICK_RATE_HZ 1000
+#define configUSE_TASK_NOTIFICATIONS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define pdTICKS_TO_MS(ticks) ((uint32_t)(ticks))
+#define portYIELD_FROM_ISR(x) ((void)(x))
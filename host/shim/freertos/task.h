@@ -0,0 +1,5 @@
+#pragma once
+#include "freertos/FreeRTOS.h"
+
+inline TickType_t xTaskGetTickCount() { return HostClockMs(); }
+inline void vTaskDelay(TickType_t ticks) { HostClockAdvanceUs((int64_t)ticks * 1000); }
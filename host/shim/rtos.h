@@ -0,0 +1,64 @@
+#pragma once
+// Host shim for lib/rtos: single-threaded stand-ins. Task never starts a
+// thread; the benchmark drives the display itself.
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <functional>
+#include <mutex>
+
+class Task
+{
+    std::function<void()> callback;
+
+public:
+    bool Init(const char *, BaseType_t, int) { return true; }
+    void SetHandler(std::function<void()> handler) { callback = std::move(handler); }
+    bool Run() { return true; }
+    bool IsRunning() const { return false; }
+    bool NotifyWait(uint32_t *bits, TickType_t = portMAX_DELAY)
+    {
+        if (bits)
+            *bits = 0;
+        return false;
+    }
+    bool Notify(uint32_t) { return true; }
+    bool NotifyFromISR(uint32_t) { return true; }
+    bool NotifyFromISR(uint32_t, BaseType_t *) { return true; }
+};
+
+class Mutex
+{
+    mutable std::recursive_mutex m;
+
+public:
+    void lock() const { m.lock(); }
+    void unlock() const { m.unlock(); }
+};
+
+#define LOCK(mutex) std::lock_guard<const Mutex> lock(mutex)
+
+class InitState
+{
+    bool ready = false;
+    bool started = false;
+
+public:
+    class Attempt
+    {
+        InitState *state;
+
+    public:
+        explicit Attempt(InitState *s) : state(s) {}
+        explicit operator bool() const { return state != nullptr; }
+        void SetReady() { if (state) state->ready = true; }
+    };
+
+    Attempt TryBeginInit()
+    {
+        if (started)
+            return Attempt(nullptr);
+        started = true;
+        return Attempt(this);
+    }
+    bool IsReady() const { return ready; }
+};
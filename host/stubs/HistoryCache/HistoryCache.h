@@ -0,0 +1,62 @@
+#pragma once
+// Host stub: answers every query from SynthSignal with the same bucket and
+// min/max/avg semantics as the PSRAM rings, back to one week.
+#include "LogManager/RollupLog.h"
+#include "SynthSignal.h"
+#include <algorithm>
+#include <cstdint>
+
+class HistoryCache
+{
+public:
+    struct TierConfig { uint32_t periodSeconds; uint32_t capacity; };
+
+    static constexpr TierConfig TIERS[] = {
+        {    1,  3600 },
+        {   10,  8640 },
+        {   60, 10080 },
+    };
+    static constexpr size_t TIER_COUNT = sizeof(TIERS) / sizeof(TIERS[0]);
+
+    /// Queries made, for the benchmark report.
+    uint32_t queries = 0;
+
+    bool Query(uint32_t from, uint32_t to, uint32_t resolution,
+               TemperaturePoint *out, size_t maxPoints, size_t &count) const
+    {
+        count = 0;
+        const_cast<HistoryCache *>(this)->queries++;
+        uint32_t oldest = SynthSignal::EPOCH - TIERS[TIER_COUNT - 1].periodSeconds * TIERS[TIER_COUNT - 1].capacity;
+        if (resolution == 0 || from >= to || from < oldest)
+            return false;
+
+        // Sample each bucket once per minute (or per second when finer)
+        uint32_t step = std::clamp<uint32_t>(resolution / 8, 1, 60);
+        for (uint32_t start = from - from % resolution; start < to && count < maxPoints; start += resolution)
+        {
+            TemperaturePoint &p = out[count++];
+            p = TemperaturePoint{};
+            p.timestamp = start;
+            for (size_t slot = 0; slot < TemperaturePoint::MAX_SLOTS; slot++)
+            {
+                int32_t sum = 0, n = 0;
+                int16_t lo = INT16_MAX, hi = INT16_MIN;
+                for (uint32_t t = start; t < start + resolution; t += step, n++)
+                {
+                    int16_t c = TemperaturePoint::ToCenti(SynthSignal::Celsius(slot, t));
+                    sum += c;
+                    lo = std::min(lo, c);
+                    hi = std::max(hi, c);
+                }
+                if (n == 0)
+                    continue;
+                p.avg[slot] = static_cast<int16_t>(sum / n);
+                p.min[slot] = lo;
+                p.max[slot] = hi;
+                p.validMask |= 1u << slot;
+                p.count = n;
+            }
+        }
+        return true;
+    }
+};
@@ -0,0 +1,33 @@
+#pragma once
+// Host stub: TemperaturePoint as defined by LogManager/RollupLog.h.
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+struct TemperaturePoint
+{
+    static constexpr size_t MAX_SLOTS = 4;
+
+    uint32_t timestamp = 0;
+    uint32_t count = 0;
+    uint8_t validMask = 0;
+    int16_t avg[MAX_SLOTS] = {};
+    int16_t min[MAX_SLOTS] = {};
+    int16_t max[MAX_SLOTS] = {};
+
+    bool IsValid(size_t slot) const { return (validMask >> slot) & 1; }
+
+    void Set(size_t slot, float celsius)
+    {
+        int16_t centi = ToCenti(celsius);
+        avg[slot] = min[slot] = max[slot] = centi;
+        validMask |= (1u << slot);
+    }
+
+    static int16_t ToCenti(float celsius)
+    {
+        return static_cast<int16_t>(std::clamp(std::lround(celsius * 100.0f), -32768L, 32767L));
+    }
+    static float FromCenti(int16_t centi) { return centi / 100.0f; }
+};
@@ -0,0 +1,9 @@
+#pragma once
+// Host stub: only the constants the display uses.
+#include <cstdint>
+
+class MonitorManager
+{
+public:
+    static constexpr int32_t DEFAULT_RATE_SECONDS = 10;
+};
@@ -0,0 +1,68 @@
+#pragma once
+// Host stub: a connected station with a fixed address and scan list.
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#define IPSTR "%d.%d.%d.%d"
+#define IP2STR(ipaddr) (int)((ipaddr)->addr & 0xff), (int)(((ipaddr)->addr >> 8) & 0xff), \
+                       (int)(((ipaddr)->addr >> 16) & 0xff), (int)(((ipaddr)->addr >> 24) & 0xff)
+
+struct esp_ip4_addr_t { uint32_t addr; };
+struct esp_netif_ip_info_t { esp_ip4_addr_t ip; esp_ip4_addr_t netmask; esp_ip4_addr_t gw; };
+
+struct NetworkStatus
+{
+    static constexpr uint8_t MacLength = 6;
+
+    bool link_up = false;
+    bool has_ipv4 = false;
+
+    esp_netif_ip_info_t ipv4 = {};
+    uint8_t mac[MacLength] = {};
+};
+
+class WiFiInterface
+{
+public:
+    struct ScanResult {
+        char ssid[33];
+        int8_t rssi;
+        uint8_t channel;
+        bool secure;
+    };
+
+    int Scan(ScanResult *out, int maxResults)
+    {
+        static const ScanResult networks[] = {
+            {"Workshop", -48, 6, true},
+            {"Thermy-Guest", -61, 1, false},
+            {"Neighbour 5G", -79, 11, true},
+        };
+        int count = 0;
+        for (const auto &n : networks)
+            if (count < maxResults)
+                out[count++] = n;
+        return count;
+    }
+
+    NetworkStatus getStatus() const
+    {
+        NetworkStatus status;
+        status.link_up = true;
+        status.has_ipv4 = true;
+        status.ipv4.ip.addr = 192 | (168 << 8) | (1 << 16) | (42u << 24);
+        return status;
+    }
+};
+
+class NetworkManager
+{
+public:
+    WiFiInterface &wifi() { return wifiInterface; }
+    const WiFiInterface &wifi() const { return wifiInterface; }
+    uint32_t GetStatusGeneration() const { return 1; }
+
+private:
+    WiFiInterface wifiInterface;
+};
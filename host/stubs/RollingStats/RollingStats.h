@@ -0,0 +1,38 @@
+#pragma once
+// Host stub: fixed statistics per slot.
+#include "LogManager/RollupLog.h"
+#include <cstddef>
+#include <cstdint>
+
+class RollingStats
+{
+public:
+    struct WindowConfig { const char *name; uint32_t bucketSeconds; uint32_t bucketCount; };
+
+    static constexpr WindowConfig WINDOWS[] = {
+        { "1h",    60,  60 },
+        { "24h",  900,  96 },
+        { "7d",  3600, 168 },
+    };
+    static constexpr size_t WINDOW_COUNT = sizeof(WINDOWS) / sizeof(WINDOWS[0]);
+    static constexpr size_t SLOTS = TemperaturePoint::MAX_SLOTS;
+
+    struct Stats
+    {
+        uint32_t count = 0;
+        float min = 0.0f;
+        float max = 0.0f;
+        float mean = 0.0f;
+        float stddev = 0.0f;
+    };
+
+    bool Get(size_t slot, size_t window, Stats &out) const
+    {
+        if (slot >= SLOTS || window >= WINDOW_COUNT || slot == 3)
+            return false;   // leave one tile without data
+        static constexpr float mid[SLOTS] = {62.0f, 21.0f, 45.0f, 8.0f};
+        float spread = 1.5f * (window + 1);
+        out = {WINDOWS[window].bucketCount, mid[slot] - spread, mid[slot] + spread, mid[slot], spread / 2};
+        return true;
+    }
+};
@@ -0,0 +1,41 @@
+#pragma once
+// Host stub: four channel sensors plus whatever the benchmark publishes.
+#include "rtos.h"
+#include "SynthSignal.h"
+#include "SensorSnapshot.h"
+#include <cstddef>
+#include <cstdint>
+
+class SensorManager
+{
+public:
+    static constexpr size_t MAX_SENSORS = SensorSnapshot::MAX_SENSORS;
+    static constexpr size_t CHANNEL_COUNT = 4;
+
+    SensorSnapshot GetSnapshot() const { return snapshot; }
+
+    /// Publish a reading of every channel at UTC second `t`. Benchmark only.
+    void Publish(uint32_t t)
+    {
+        snapshot.sequence++;
+        snapshot.timestampUs = HostClockUs();
+        for (size_t i = 0; i < CHANNEL_COUNT; i++)
+        {
+            snapshot.activeMask |= 1ull << i;
+            snapshot.address[i] = 0x28000000000000ull + i;
+            snapshot.temperatureC[i] = SynthSignal::Celsius(i, t);
+        }
+    }
+
+    bool HasPendingSensor() { return pending != 0; }
+    uint64_t GetPendingSensorAddress() { return pending; }
+    void AssignPendingToSlot(int) { pending = 0; }
+    void DismissPendingSensor() { pending = 0; }
+    void ClearAllSlots() { snapshot.activeMask = 0; }
+    bool Subscribe(Task &, uint32_t) { return true; }
+    bool SubscribePending(Task &, uint32_t) { return true; }
+
+private:
+    SensorSnapshot snapshot;
+    uint64_t pending = 0;
+};
@@ -0,0 +1,42 @@
+#pragma once
+// Host stub: settings in a map, starting empty so every getter returns its
+// default.
+#include "rtos.h"
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+
+class SettingsManager
+{
+public:
+    bool getString(const char *key, char *out, size_t maxLen) const
+    {
+        auto it = strings.find(key);
+        if (it == strings.end())
+        {
+            if (maxLen)
+                out[0] = '\0';
+            return false;
+        }
+        snprintf(out, maxLen, "%s", it->second.c_str());
+        return true;
+    }
+    bool setString(const char *key, const char *value) { strings[key] = value; return true; }
+
+    int32_t getInt(const char *key, int32_t defaultVal = 0) const
+    {
+        auto it = ints.find(key);
+        return it == ints.end() ? defaultVal : it->second;
+    }
+    bool setInt(const char *key, int32_t value) { ints[key] = value; return true; }
+
+    bool getBool(const char *key, bool defaultVal = false) const { return getInt(key, defaultVal) != 0; }
+    bool setBool(const char *key, bool value) { return setInt(key, value); }
+
+    bool Save() { return true; }
+
+private:
+    std::map<std::string, std::string> strings;
+    std::map<std::string, int32_t> ints;
+};
@@ -0,0 +1,23 @@
+#pragma once
+// Deterministic synthetic temperatures shared by the host stubs, so every
+// run of the benchmark renders the same pixels.
+#include "HostRuntime.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace SynthSignal
+{
+    static constexpr uint32_t EPOCH = HOST_EPOCH_UTC;
+
+    /// Channel `slot` at UTC second `t`: a daily swing plus a faster ripple.
+    inline float Celsius(size_t slot, uint32_t t)
+    {
+        static constexpr float base[4] = {62.0f, 21.0f, 45.0f, 8.0f};
+        static constexpr float swing[4] = {6.0f, 2.5f, 4.0f, 1.5f};
+        double day = (t % 86400) / 86400.0 * 2 * M_PI;
+        double ripple = (t % 600) / 600.0 * 2 * M_PI;
+        return base[slot % 4] + swing[slot % 4] * static_cast<float>(std::sin(day + slot))
+             + 0.4f * static_cast<float>(std::sin(ripple * (slot + 1)));
+    }
+}
@@ -0,0 +1,277 @@
+#include "AlarmManager.h"
+#include "LogManager.h"
+#include "MqttManager.h"
+#include "SettingsManager.h"
+#include "WebServerManager.h"
+#include "JsonWriter.h"
+#include "BufferStream.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+AlarmManager::AlarmManager(ServiceProvider& serviceProvider)
+    : serviceProvider_(serviceProvider)
+{
+}
+
+void AlarmManager::Init()
+{
+    auto initAttempt = initState_.TryBeginInit();
+    if (!initAttempt)
+    {
+        return;
+    }
+
+    LoadConfig();
+    configLoadedUs_ = esp_timer_get_time();
+
+    task_.Init("Alarm", 5, 4096);
+    task_.SetHandler([this]() { Work(); });
+    task_.Run();
+
+    serviceProvider_.getSensorManager().AddReadingHandler(
+        [this](const SensorSnapshot& snapshot) { OnReading(snapshot); });
+
+    initAttempt.SetReady();
+    ESP_LOGI(TAG, "Initialized");
+}
+
+uint32_t AlarmManager::GetActiveMask()
+{
+    LOCK(mutex_);
+    return activeMask_;
+}
+
+AlarmManager::Stats AlarmManager::GetStats()
+{
+    LOCK(mutex_);
+    return stats_;
+}
+
+const char* AlarmManager::KindName(Kind kind)
+{
+    switch (kind)
+    {
+    case Kind::High: return "high";
+    case Kind::Low:  return "low";
+    case Kind::Rate: return "rate";
+    }
+    return "unknown";
+}
+
+void AlarmManager::LoadConfig()
+{
+    // Settings are in 0.1 °C (0.1 °C/min for the rate)
+    auto& settings = serviceProvider_.getSettingsManager();
+    char key[16];
+    for (size_t slot = 0; slot < SLOTS; slot++)
+    {
+        SlotConfig& cfg = config_[slot];
+        unsigned n = static_cast<unsigned>(slot + 1);
+        snprintf(key, sizeof(key), "alarm%u.highon", n);
+        cfg.highOn = settings.getBool(key, false);
+        snprintf(key, sizeof(key), "alarm%u.high", n);
+        cfg.high = settings.getInt(key, 0) * 10;
+        snprintf(key, sizeof(key), "alarm%u.lowon", n);
+        cfg.lowOn = settings.getBool(key, false);
+        snprintf(key, sizeof(key), "alarm%u.low", n);
+        cfg.low = settings.getInt(key, 0) * 10;
+        snprintf(key, sizeof(key), "alarm%u.hyst", n);
+        cfg.hysteresis = std::abs(settings.getInt(key, 5)) * 10;
+        snprintf(key, sizeof(key), "alarm%u.rateon", n);
+        cfg.rateOn = settings.getBool(key, false);
+        snprintf(key, sizeof(key), "alarm%u.rate", n);
+        cfg.rate = std::abs(settings.getInt(key, 0)) * 10;
+        snprintf(key, sizeof(key), "alarm%u.ratehyst", n);
+        cfg.rateHysteresis = std::abs(settings.getInt(key, 5)) * 10;
+    }
+}
+
+// ── Evaluation (sensor task) ─────────────────────────────────
+
+void AlarmManager::OnReading(const SensorSnapshot& snapshot)
+{
+    // Cheap enough to do inline, but not on every 100 ms burst cycle
+    if (snapshot.timestampUs - configLoadedUs_ >= CONFIG_RELOAD_US)
+    {
+        LoadConfig();
+        configLoadedUs_ = snapshot.timestampUs;
+    }
+
+    uint32_t before = activeMask_;
+    for (size_t slot = 0; slot < SLOTS; slot++)
+    {
+        const SlotConfig& cfg = config_[slot];
+
+        if (!snapshot.IsActive(slot))
+        {
+            // A gap would show up as a step; start the slope over
+            rates_[slot].count = 0;
+
+            // Nothing to hold a raised alarm against any more
+            const int32_t limits[KIND_COUNT] = { cfg.high, cfg.low, cfg.rate };
+            for (size_t kind = 0; kind < KIND_COUNT; kind++)
+            {
+                if (activeMask_ & (1u << (slot * KIND_COUNT + kind)))
+                    Transition(snapshot, slot, static_cast<Kind>(kind), false, NAN, limits[kind]);
+            }
+            continue;
+        }
+
+        float value = snapshot.temperatureC[slot];
+        int32_t centi = static_cast<int32_t>(lroundf(value * 100.0f));
+
+        // Raise on reaching the limit; clear once back past it by the
+        // hysteresis, or when the limit is switched off
+        auto check = [&](Kind kind, bool enabled, bool raise, bool clear, float shown, int32_t limit) {
+            uint32_t bit = 1u << (slot * KIND_COUNT + static_cast<size_t>(kind));
+            bool on = activeMask_ & bit;
+            if (!on && enabled && raise)
+                Transition(snapshot, slot, kind, true, shown, limit);
+            else if (on && (!enabled || clear))
+                Transition(snapshot, slot, kind, false, shown, limit);
+        };
+
+        check(Kind::High, cfg.highOn, centi >= cfg.high, centi < cfg.high - cfg.hysteresis, value, cfg.high);
+        check(Kind::Low, cfg.lowOn, centi <= cfg.low, centi > cfg.low + cfg.hysteresis, value, cfg.low);
+
+        int32_t rate = 0;
+        bool haveRate = UpdateRate(rates_[slot], snapshot.timestampUs, centi, rate);
+        int32_t slope = std::abs(rate);
+        check(Kind::Rate, cfg.rateOn, haveRate && slope >= cfg.rate,
+              haveRate && slope < cfg.rate - cfg.rateHysteresis, rate / 100.0f, cfg.rate);
+    }
+
+    if (activeMask_ != before)
+        task_.Notify(NOTIFY_EVENT);
+}
+
+bool AlarmManager::UpdateRate(RateHistory& history, int64_t nowUs, int32_t centi, int32_t& ratePerMin)
+{
+    size_t newest = (history.head + RATE_HISTORY - 1) % RATE_HISTORY;
+    if (history.count == 0 || nowUs - history.timeUs[newest] >= RATE_SPACING_US)
+    {
+        history.timeUs[history.head] = nowUs;
+        history.centi[history.head] = centi;
+        history.head = (history.head + 1) % RATE_HISTORY;
+        if (history.count < RATE_HISTORY)
+            history.count++;
+    }
+
+    size_t oldest = (history.head + RATE_HISTORY - history.count) % RATE_HISTORY;
+    int64_t spanUs = nowUs - history.timeUs[oldest];
+    if (spanUs < RATE_MIN_SPAN_US)
+        return false;
+
+    ratePerMin = static_cast<int32_t>((centi - history.centi[oldest]) * 60000000LL / spanUs);
+    return true;
+}
+
+void AlarmManager::Transition(const SensorSnapshot& snapshot, size_t slot, Kind kind, bool active,
+                              float value, int32_t limit)
+{
+    uint32_t bit = 1u << (slot * KIND_COUNT + static_cast<size_t>(kind));
+
+    LOCK(mutex_);
+    if (active)
+    {
+        activeMask_ |= bit;
+        stats_.raised++;
+    }
+    else
+    {
+        activeMask_ &= ~bit;
+        stats_.cleared++;
+    }
+
+    if (queueCount_ >= QUEUE_CAPACITY)
+    {
+        stats_.dropped++;
+        return;
+    }
+
+    Event& event = queue_[(queueHead_ + queueCount_++) % QUEUE_CAPACITY];
+    event.detectedUs = snapshot.timestampUs;
+    event.time = DateTime::Now();
+    event.value = value;
+    event.limit = limit;
+    event.slot = static_cast<uint8_t>(slot);
+    event.kind = kind;
+    event.active = active;
+}
+
+// ── Notification (alarm task) ────────────────────────────────
+
+void AlarmManager::Work()
+{
+    while (true)
+    {
+        task_.NotifyWait(nullptr, portMAX_DELAY);
+
+        while (true)
+        {
+            Event event;
+            {
+                LOCK(mutex_);
+                if (queueCount_ == 0)
+                    break;
+                event = queue_[queueHead_];
+                queueHead_ = (queueHead_ + 1) % QUEUE_CAPACITY;
+                queueCount_--;
+            }
+            Dispatch(event);
+        }
+    }
+}
+
+void AlarmManager::Dispatch(const Event& event)
+{
+    // {"slot":0,"type":"high","active":true,"value":81.2,"limit":80.0,"time":...},
+    // value null when cleared because the sensor was lost
+    char buf[192];
+    int prefix = snprintf(buf, sizeof(buf), "{\"alarm\":");
+    BufferStream stream(buf + prefix, sizeof(buf) - prefix - 1);
+    JsonWriter json(stream);
+    json.beginObject();
+    json.field("slot", static_cast<int32_t>(event.slot));
+    json.field("type", KindName(event.kind));
+    json.field("active", event.active);
+    if (std::isnan(event.value))
+        json.nullField("value");
+    else
+        json.field("value", event.value);
+    json.field("limit", event.limit / 100.0f);
+    json.field("time", static_cast<uint32_t>(event.time.UtcSeconds()));
+    json.endObject();
+
+    // MQTT gets the bare object, WebSocket clients the wrapped one
+    serviceProvider_.getMqttManager().Publish("alarm", buf + prefix);
+    size_t length = prefix + stream.length();
+    buf[length++] = '}';
+    buf[length] = '\0';
+    serviceProvider_.getWebServerManager().Broadcast(buf, static_cast<int>(length));
+
+    uint32_t latencyUs = static_cast<uint32_t>(esp_timer_get_time() - event.detectedUs);
+    {
+        LOCK(mutex_);
+        stats_.lastLatencyUs = latencyUs;
+        if (latencyUs > stats_.maxLatencyUs)
+            stats_.maxLatencyUs = latencyUs;
+    }
+
+    uint32_t info = event.slot | (static_cast<uint32_t>(event.kind) << 8);
+    serviceProvider_.getLogManager().Append(
+        LogKeys::TimeStamp, event.time,
+        LogKeys::LogCode, static_cast<uint32_t>(event.active ? LogCode::AlarmRaised : LogCode::AlarmCleared),
+        LogKeys::AlarmInfo, info,
+        LogKeys::AlarmValue, event.value);
+
+    if (event.active)
+        ESP_LOGW(TAG, "Slot %u %s alarm raised (%.2f, limit %.2f, %lu us)", event.slot,
+                 KindName(event.kind), event.value, event.limit / 100.0f, (unsigned long)latencyUs);
+    else
+        ESP_LOGI(TAG, "Slot %u %s alarm cleared%s", event.slot, KindName(event.kind),
+                 std::isnan(event.value) ? " (sensor lost)" : "");
+}
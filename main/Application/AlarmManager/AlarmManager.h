@@ -0,0 +1,127 @@
+#pragma once
+
+#include "ServiceProvider.h"
+#include "InitState.h"
+#include "Mutex.h"
+#include "Task.h"
+#include "SensorManager.h"
+#include "DateTime.h"
+#include <cstdint>
+
+/// Threshold alarms on the colour channels, evaluated on every read cycle.
+///
+/// Runs as a SensorManager reading handler, so a reading is checked in the
+/// sensor task the moment its cycle completes. Per channel (settings
+/// `alarmN.*`, N = 1-4), each kind switched on by its own `...on` flag so any
+/// limit, 0 °C included, can be used:
+///  - High / Low (`high`, `low`, `hyst`): raised when the reading reaches the
+///    limit, cleared once it is back past the limit by the hysteresis
+///  - Rate (`rate`, `ratehyst`): raised when the slope over the last ~30 s
+///    reaches the limit (either direction), cleared once it drops below the
+///    limit minus its own hysteresis in °C/min
+///
+/// When a channel's sensor goes missing its raised alarms are cleared with no
+/// value ("sensor lost"); they are raised again once it is back and still past
+/// the limit.
+///
+/// Evaluation only queues the transition; the "Alarm" task then publishes it
+/// on MQTT (`alarm`), broadcasts it to WebSocket clients and writes an
+/// AlarmRaised / AlarmCleared log entry. The time from the reading to the
+/// MQTT and WebSocket push is tracked as the alarm latency.
+class AlarmManager
+{
+    static constexpr const char* TAG = "AlarmManager";
+    static constexpr uint32_t NOTIFY_EVENT = 1u << 0;
+    static constexpr size_t QUEUE_CAPACITY = 16;
+    static constexpr int64_t CONFIG_RELOAD_US = 5 * 1000000LL;
+    static constexpr size_t RATE_HISTORY = 31;              // one entry per second
+    static constexpr int64_t RATE_SPACING_US = 1000000;
+    static constexpr int64_t RATE_MIN_SPAN_US = 10 * 1000000LL;
+
+public:
+    static constexpr size_t SLOTS = SensorManager::CHANNEL_COUNT;
+
+    enum class Kind : uint8_t { High, Low, Rate };
+    static constexpr size_t KIND_COUNT = 3;
+
+    struct Stats
+    {
+        uint32_t raised;
+        uint32_t cleared;
+        uint32_t dropped;           // transitions lost to a full queue
+        uint32_t lastLatencyUs;     // reading to MQTT + WebSocket push
+        uint32_t maxLatencyUs;
+    };
+
+    explicit AlarmManager(ServiceProvider& serviceProvider);
+
+    AlarmManager(const AlarmManager&) = delete;
+    AlarmManager& operator=(const AlarmManager&) = delete;
+
+    void Init();
+
+    /// Bit (slot * KIND_COUNT + kind) set for every raised alarm.
+    uint32_t GetActiveMask();
+    Stats GetStats();
+
+    static const char* KindName(Kind kind);
+
+private:
+    // Limits in centi-°C (rate in centi-°C per minute)
+    struct SlotConfig
+    {
+        bool highOn = false;
+        bool lowOn = false;
+        bool rateOn = false;
+        int32_t high = 0;
+        int32_t low = 0;
+        int32_t rate = 0;
+        int32_t hysteresis = 0;
+        int32_t rateHysteresis = 0;
+    };
+
+    // Recent readings at >= 1 s spacing, for the rate of change
+    struct RateHistory
+    {
+        int64_t timeUs[RATE_HISTORY];
+        int32_t centi[RATE_HISTORY];
+        uint8_t head = 0;           // next write position
+        uint8_t count = 0;
+    };
+
+    struct Event
+    {
+        int64_t detectedUs;         // esp_timer time of the reading
+        DateTime time;
+        float value;                // °C, or °C/min for a rate alarm; NaN when the sensor was lost
+        int32_t limit;              // centi-°C (per minute for rate)
+        uint8_t slot;
+        Kind kind;
+        bool active;
+    };
+
+    ServiceProvider& serviceProvider_;
+    InitState initState_;
+    mutable Mutex mutex_;
+    Task task_;
+
+    // Sensor task only
+    SlotConfig config_[SLOTS];
+    int64_t configLoadedUs_ = 0;
+    RateHistory rates_[SLOTS];
+
+    // Guarded by mutex_; activeMask_ is only written by the sensor task
+    uint32_t activeMask_ = 0;
+    Event queue_[QUEUE_CAPACITY];
+    size_t queueHead_ = 0;
+    size_t queueCount_ = 0;
+    Stats stats_ = {};
+
+    void LoadConfig();
+    void OnReading(const SensorSnapshot& snapshot);
+    bool UpdateRate(RateHistory& history, int64_t nowUs, int32_t centi, int32_t& ratePerMin);
+    void Transition(const SensorSnapshot& snapshot, size_t slot, Kind kind, bool active,
+                    float value, int32_t limit);
+    void Work();
+    void Dispatch(const Event& event);
+};
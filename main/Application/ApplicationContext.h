@@ -1,13 +1,17 @@
 #pragma once
 #include "ServiceProvider.h"
+#include "AlarmManager/AlarmManager.h"
+#include "BurstManager/BurstManager.h"
 #include "CommandManager/CommandManager.h"
 #include "DeviceManager/DeviceManager.h"
 #include "DisplayManager/DisplayManager.h"
+#include "HistoryCache/HistoryCache.h"
 #include "HomeAssistantManager/HomeAssistantManager.h"
 #include "ConsoleManager/ConsoleManager.h"
 #include "LogManager/LogManager.h"
 #include "MqttManager/MqttManager.h"
 #include "NetworkManager/NetworkManager.h"
+#include "RollingStats/RollingStats.h"
 #include "SensorManager/SensorManager.h"
 #include "SettingsManager/SettingsManager.h"
 #include "MonitorManager/MonitorManager.h"
@@ -23,14 +27,18 @@ public:
     ApplicationContext(const ApplicationContext&) = delete;
     ApplicationContext& operator=(const ApplicationContext&) = delete;
 
+    AlarmManager& getAlarmManager() override { return m_alarmManager; }
+    BurstManager& getBurstManager() override { return m_burstManager; }
     CommandManager& getCommandManager() override { return m_commandManager; }
     DeviceManager& getDeviceManager() override { return m_deviceManager; }
     DisplayManager& getDisplayManager() override { return m_displayManager; }
+    HistoryCache& getHistoryCache() override { return m_historyCache; }
     HomeAssistantManager& getHomeAssistantManager() override { return m_homeAssistantManager; }
     ConsoleManager& getConsoleManager() override { return m_consoleManager; }
     LogManager& getLogManager() override { return m_logManager; }
     MqttManager& getMqttManager() override { return m_mqttManager; }
     NetworkManager& getNetworkManager() override { return m_networkManager; }
+    RollingStats& getRollingStats() override { return m_rollingStats; }
     SensorManager& getSensorManager() override { return m_sensorManager; }
     SettingsManager& getSettingsManager() override { return m_settingsManager; }
     MonitorManager& getMonitorManager() override { return m_monitorManager; }
@@ -41,6 +49,8 @@ public:
 private:
     ConsoleManager m_consoleManager{*this};
     LogManager m_logManager{*this};
+    HistoryCache m_historyCache{*this};
+    RollingStats m_rollingStats{*this};
     SettingsManager m_settingsManager{*this};
     NetworkManager m_networkManager{*this};
     SensorManager m_sensorManager{*this};
@@ -51,6 +61,8 @@ private:
     MqttManager m_mqttManager{*this};
     DeviceManager m_deviceManager{*this};
     HomeAssistantManager m_homeAssistantManager{*this};
+    BurstManager m_burstManager{*this};
+    AlarmManager m_alarmManager{*this};
     UpdateManager m_updateManager{*this};
     WebServerManager m_webServerManager{*this};
 };
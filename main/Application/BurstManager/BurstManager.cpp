@@ -0,0 +1,445 @@
+#include "BurstManager.h"
+#include "LogManager.h"
+#include "MqttManager.h"
+#include "SettingsManager.h"
+#include "RollupLog.h"
+#include "JsonWriter.h"
+#include "DateTime.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include <cstring>
+#include <cstdlib>
+
+static uint32_t UptimeMs()
+{
+    return static_cast<uint32_t>(esp_timer_get_time() / 1000);
+}
+
+BurstManager::BurstManager(ServiceProvider& serviceProvider)
+    : serviceProvider_(serviceProvider)
+{
+}
+
+void BurstManager::Init()
+{
+    auto initAttempt = initState_.TryBeginInit();
+    if (!initAttempt)
+    {
+        return;
+    }
+
+    auto& settings = serviceProvider_.getSettingsManager();
+    preSeconds_ = settings.getInt("burst.pre", DEFAULT_PRE_SECONDS);
+    durationSeconds_ = settings.getInt("burst.dur", DEFAULT_DURATION_SECONDS);
+    int32_t bits = settings.getInt("burst.res", DEFAULT_RESOLUTION_BITS);
+    resolutionBits_ = static_cast<uint8_t>(bits < 9 ? 9 : bits > 12 ? 12 : bits);
+    thresholdEnabled_ = settings.getBool("burst.trigger", false);
+    thresholdCenti_ = settings.getInt("burst.thresh", 0) * 100;
+    if (durationSeconds_ < 1) durationSeconds_ = 1;
+    if (preSeconds_ < 0) preSeconds_ = 0;
+
+    // Ring and encode buffer in PSRAM
+    ring_ = static_cast<Sample*>(
+        heap_caps_calloc(RING_CAPACITY, sizeof(Sample), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (!ring_)
+        ring_ = static_cast<Sample*>(calloc(RING_CAPACITY, sizeof(Sample)));
+    assert(ring_ && "Failed to allocate burst ring");
+
+    encodeBuf_ = static_cast<uint8_t*>(
+        heap_caps_malloc(MAX_BLOCK_BYTES, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+    if (!encodeBuf_)
+        encodeBuf_ = static_cast<uint8_t*>(malloc(MAX_BLOCK_BYTES));
+    assert(encodeBuf_ && "Failed to allocate burst encode buffer");
+
+    if (!flash_.mount(PARTITION_LABEL))
+    {
+        ESP_LOGE(TAG, "Failed to mount partition '%s'", PARTITION_LABEL);
+    }
+    else if (!log_.init())
+    {
+        ESP_LOGI(TAG, "No valid burst log, formatting");
+        mounted_ = log_.format(KEY_SIZE, VALUE_SIZE) && log_.init();
+    }
+    else
+    {
+        mounted_ = true;
+    }
+
+    serviceProvider_.getSensorManager().AddReadingHandler(
+        [this](const SensorSnapshot& snapshot) { OnReading(snapshot); });
+
+    serviceProvider_.getMqttManager().RegisterCommand("burst", [this](const char* data, int len)
+    {
+        if (len >= 2 && strncmp(data, "ON", 2) == 0)
+            Start(Trigger::Mqtt);
+        else
+            Stop();
+    });
+
+    task_.Init("Burst", 3, 4096);
+    task_.SetHandler([this]() { Work(); });
+    task_.Run();
+
+    initAttempt.SetReady();
+    ESP_LOGI(TAG, "Initialized (%lu captures stored, %lds pre / %lds at %u-bit)",
+             mounted_ ? (unsigned long)log_.entryCount() : 0ul,
+             preSeconds_, durationSeconds_, resolutionBits_);
+}
+
+// ── Control ──────────────────────────────────────────────────
+
+bool BurstManager::Start(Trigger source)
+{
+    if (!initState_.IsReady())
+        return false;
+
+    {
+        LOCK(mutex_);
+        if (state_ != State::Idle)
+            return false;
+
+        state_ = State::Capturing;
+        source_ = source;
+        triggerMs_ = UptimeMs();
+        triggerUtc_ = static_cast<uint32_t>(DateTime::Now().UtcSeconds());
+        endMs_ = triggerMs_ + durationSeconds_ * 1000;
+    }
+
+    serviceProvider_.getSensorManager().SetBurstMode(true, resolutionBits_);
+    ESP_LOGI(TAG, "Capture started (source %u, %lds)", static_cast<unsigned>(source), durationSeconds_);
+    return true;
+}
+
+void BurstManager::Stop()
+{
+    {
+        LOCK(mutex_);
+        if (state_ != State::Capturing)
+            return;
+        state_ = State::Committing;
+        endMs_ = UptimeMs();
+    }
+    task_.Notify(1);
+}
+
+bool BurstManager::IsCapturing()
+{
+    LOCK(mutex_);
+    return state_ != State::Idle;
+}
+
+void BurstManager::OnReading(const SensorSnapshot& snapshot)
+{
+    uint32_t now = UptimeMs();
+    const float* temperatures = snapshot.temperatureC;
+    uint8_t activeMask = static_cast<uint8_t>(snapshot.activeMask & ((1u << SLOTS) - 1));
+    bool crossed = false;
+    bool finished = false;
+
+    {
+        LOCK(mutex_);
+
+        Sample& sample = ring_[head_];
+        sample.uptimeMs = now;
+        sample.validMask = activeMask;
+        for (size_t s = 0; s < SLOTS; s++)
+            sample.centi[s] = (activeMask >> s) & 1 ? TemperaturePoint::ToCenti(temperatures[s]) : 0;
+
+        head_ = (head_ + 1) % RING_CAPACITY;
+        if (count_ < RING_CAPACITY) count_++;
+
+        // Rising crossing of the trigger threshold on any slot
+        if (state_ == State::Idle && thresholdEnabled_)
+        {
+            for (size_t s = 0; s < SLOTS; s++)
+            {
+                uint8_t bit = 1u << s;
+                if ((activeMask & lastMask_ & bit) && lastCenti_[s] < thresholdCenti_ && sample.centi[s] >= thresholdCenti_)
+                    crossed = true;
+            }
+        }
+        memcpy(lastCenti_, sample.centi, sizeof(lastCenti_));
+        lastMask_ = activeMask;
+
+        if (state_ == State::Capturing && static_cast<int32_t>(now - endMs_) >= 0)
+        {
+            state_ = State::Committing;
+            finished = true;
+        }
+    }
+
+    if (crossed)
+        Start(Trigger::Threshold);
+    if (finished)
+        task_.Notify(1);
+}
+
+// ── Commit ───────────────────────────────────────────────────
+
+void BurstManager::Work()
+{
+    while (true)
+    {
+        task_.NotifyWait(nullptr, portMAX_DELAY);
+
+        bool commit;
+        {
+            LOCK(mutex_);
+            commit = state_ == State::Committing;
+        }
+        if (commit)
+            Commit();
+    }
+}
+
+void BurstManager::Commit()
+{
+    serviceProvider_.getSensorManager().SetBurstMode(false);
+
+    BlockHeader header = {};
+    size_t length = 0;
+    bool ok = false;
+    {
+        LOCK(mutex_);
+
+        // Pick the ring window [trigger - pre, end]
+        uint32_t windowStart = triggerMs_ - preSeconds_ * 1000;
+        size_t oldest = (head_ + RING_CAPACITY - count_) % RING_CAPACITY;
+        size_t first = SIZE_MAX;
+        size_t n = 0;
+        for (size_t i = 0; i < count_; i++)
+        {
+            size_t idx = (oldest + i) % RING_CAPACITY;
+            uint32_t t = ring_[idx].uptimeMs;
+            if (static_cast<int32_t>(t - windowStart) < 0) continue;
+            if (static_cast<int32_t>(t - endMs_) > 0) break;
+            if (first == SIZE_MAX) first = idx;
+            n++;
+        }
+
+        if (first != SIZE_MAX)
+            length = Encode(first, n, header);
+        state_ = State::Idle;
+    }
+
+    // The erase and write take long; under the flash lock only, so readings
+    // keep flowing and readers never see a half-written entry. encodeBuf_ is
+    // only touched by this task.
+    if (length > 0)
+    {
+        LOCK(flashMutex_);
+        if (mounted_ && log_.beginEntry())
+        {
+            auto headerKey = static_cast<uint8_t>(BurstKeys::Header);
+            auto dataKey = static_cast<uint8_t>(BurstKeys::Data);
+            ok = log_.field(&headerKey, &header, sizeof(header))
+              && log_.field(&dataKey, encodeBuf_, length);
+            ok = log_.finishEntry() && ok;
+        }
+    }
+
+    if (length == 0)
+    {
+        ESP_LOGW(TAG, "Capture empty, nothing committed");
+        return;
+    }
+
+    if (!ok)
+    {
+        ESP_LOGE(TAG, "Failed to commit capture");
+        return;
+    }
+
+    serviceProvider_.getLogManager().Append(
+        LogKeys::TimeStamp, header.startUtc,
+        LogKeys::LogCode, static_cast<uint32_t>(LogCode::BurstCaptured),
+        LogKeys::SampleCount, static_cast<uint32_t>(header.sampleCount));
+
+    ESP_LOGI(TAG, "Committed %u samples over %lums in %u bytes",
+             header.sampleCount, (unsigned long)header.durationMs, (unsigned)length);
+}
+
+size_t BurstManager::Encode(size_t first, size_t n, BlockHeader& header)
+{
+    // Worst case per sample: 5-byte time varint, mask byte, 3 bytes per slot
+    static constexpr size_t MAX_SAMPLE_BYTES = 5 + 1 + 3 * SLOTS;
+
+    const Sample& head = ring_[first];
+    uint32_t prevMs = head.uptimeMs;
+    uint8_t prevMask = 0;
+    int16_t prev[SLOTS] = {};
+    size_t pos = 0;
+    size_t written = 0;
+
+    for (size_t i = 0; i < n && written < UINT16_MAX; i++)
+    {
+        if (pos + MAX_SAMPLE_BYTES > MAX_BLOCK_BYTES)
+        {
+            ESP_LOGW(TAG, "Capture truncated at %u samples", (unsigned)written);
+            break;
+        }
+
+        const Sample& sample = ring_[(first + i) % RING_CAPACITY];
+        bool maskChanged = sample.validMask != prevMask;
+
+        pos = PutVarint(encodeBuf_, pos, MAX_BLOCK_BYTES, ((sample.uptimeMs - prevMs) << 1) | (maskChanged ? 1 : 0));
+        if (maskChanged)
+            encodeBuf_[pos++] = sample.validMask;
+
+        for (size_t s = 0; s < SLOTS; s++)
+        {
+            if (!((sample.validMask >> s) & 1))
+                continue;
+            pos = PutVarint(encodeBuf_, pos, MAX_BLOCK_BYTES, ZigZag(sample.centi[s] - prev[s]));
+            prev[s] = sample.centi[s];
+        }
+
+        header.slotMask |= sample.validMask;
+        header.durationMs = sample.uptimeMs - head.uptimeMs;
+        prevMs = sample.uptimeMs;
+        prevMask = sample.validMask;
+        written++;
+    }
+
+    uint32_t preMs = triggerMs_ - head.uptimeMs;
+    header.startUtc = triggerUtc_ - preMs / 1000;
+    header.triggerOffsetMs = preMs;
+    header.sampleCount = static_cast<uint16_t>(written);
+    header.source = static_cast<uint8_t>(source_);
+    header.resolutionBits = resolutionBits_;
+    return pos;
+}
+
+size_t BurstManager::PutVarint(uint8_t* buf, size_t pos, size_t cap, uint32_t value)
+{
+    while (value >= 0x80 && pos < cap)
+    {
+        buf[pos++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    if (pos < cap)
+        buf[pos++] = static_cast<uint8_t>(value);
+    return pos;
+}
+
+bool BurstManager::GetVarint(const uint8_t* buf, size_t len, size_t& pos, uint32_t& value)
+{
+    value = 0;
+    for (uint32_t shift = 0; shift < 35 && pos < len; shift += 7)
+    {
+        uint8_t byte = buf[pos++];
+        value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+// ── Readback ─────────────────────────────────────────────────
+
+void BurstManager::WriteList(JsonWriter& json)
+{
+    json.fieldArray("captures");
+
+    LOCK(flashMutex_);
+    if (mounted_)
+    {
+        uint32_t index = 0;
+        for (auto entry : log_)
+        {
+            BlockHeader header = {};
+            if (entry.readData(0, &header, sizeof(header)) != sizeof(header))
+                continue;
+
+            json.beginObject();
+            json.field("index", index++);
+            json.field("startUtc", header.startUtc);
+            json.field("triggerOffsetMs", header.triggerOffsetMs);
+            json.field("durationMs", header.durationMs);
+            json.field("sampleCount", static_cast<uint32_t>(header.sampleCount));
+            json.field("source", static_cast<uint32_t>(header.source));
+            json.field("resolution", static_cast<uint32_t>(header.resolutionBits));
+            json.endObject();
+        }
+    }
+
+    json.endArray();
+}
+
+bool BurstManager::WriteCapture(JsonWriter& json, uint32_t index, uint32_t offset, uint32_t limit)
+{
+    LOCK(flashMutex_);
+    if (!mounted_)
+        return false;
+
+    uint32_t i = 0;
+    for (auto entry : log_)
+    {
+        BlockHeader header = {};
+        if (entry.readData(0, &header, sizeof(header)) != sizeof(header))
+            continue;
+        if (i++ != index)
+            continue;
+
+        auto* data = static_cast<uint8_t*>(malloc(MAX_BLOCK_BYTES));
+        if (!data)
+            return false;
+        size_t len = entry.readData(1, data, MAX_BLOCK_BYTES);
+
+        json.field("index", index);
+        json.field("startUtc", header.startUtc);
+        json.field("triggerOffsetMs", header.triggerOffsetMs);
+        json.field("durationMs", header.durationMs);
+        json.field("sampleCount", static_cast<uint32_t>(header.sampleCount));
+        json.field("resolution", static_cast<uint32_t>(header.resolutionBits));
+        json.field("offset", offset);
+        json.fieldArray("samples");
+
+        size_t pos = 0;
+        uint32_t t = 0;
+        uint8_t mask = 0;
+        int32_t value[SLOTS] = {};
+        for (uint32_t n = 0; n < header.sampleCount && n < offset + limit; n++)
+        {
+            uint32_t head;
+            if (!GetVarint(data, len, pos, head)) break;
+            t += head >> 1;
+            if (head & 1)
+            {
+                if (pos >= len) break;
+                mask = data[pos++];
+            }
+            for (size_t s = 0; s < SLOTS; s++)
+            {
+                if (!((mask >> s) & 1)) continue;
+                uint32_t delta;
+                if (!GetVarint(data, len, pos, delta)) break;
+                value[s] += UnZigZag(delta);
+            }
+
+            if (n < offset) continue;
+            json.beginArray();
+            json.value(t);
+            for (size_t s = 0; s < SLOTS; s++)
+            {
+                if ((mask >> s) & 1) json.value(value[s]);
+                else json.nullValue();
+            }
+            json.endArray();
+        }
+
+        json.endArray();
+        free(data);
+        return true;
+    }
+    return false;
+}
+
+bool BurstManager::Erase()
+{
+    LOCK(flashMutex_);
+    if (!mounted_) return false;
+    if (!log_.format(KEY_SIZE, VALUE_SIZE)) return false;
+    return log_.init();
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "ServiceProvider.h"
+#include "InitState.h"
+#include "Mutex.h"
+#include "Task.h"
+#include "EspFlash.h"
+#include "flash_log.h"
+#include "SensorManager.h"
+#include <cstdint>
+
+class JsonWriter;
+
+/// High-rate capture of short thermal transients.
+///
+/// Every sensor read cycle lands in a PSRAM ring, so at any time the last
+/// `burst.pre` seconds are available as pre-trigger history. A trigger (WS
+/// command, MQTT `set/burst`, or with `burst.trigger` on, a slot rising
+/// through `burst.thresh`) puts SensorManager into back-to-back conversions
+/// at `burst.res` bits for `burst.dur` seconds. The capture is then delta-encoded and written to the
+/// `burst` partition as a single entry.
+///
+/// Block format (one FlashLog entry):
+///   Header — packed BlockHeader
+///   Data   — per sample: varint(dtMs << 1 | maskChanged), [mask byte],
+///            then per valid slot a zigzag varint of the centi-°C delta
+///            against that slot's previous value.
+class BurstManager
+{
+    static constexpr const char* TAG = "BurstManager";
+    static constexpr const char* PARTITION_LABEL = "burst";
+    static constexpr size_t KEY_SIZE = sizeof(uint8_t);
+    static constexpr size_t VALUE_SIZE = 128;
+    static constexpr size_t RING_CAPACITY = 8192;
+    static constexpr size_t MAX_BLOCK_BYTES = 62 * VALUE_SIZE;   // 63 segments minus the header
+    static constexpr size_t SLOTS = SensorManager::CHANNEL_COUNT;
+
+public:
+    static constexpr int32_t DEFAULT_PRE_SECONDS = 30;
+    static constexpr int32_t DEFAULT_DURATION_SECONDS = 120;
+    static constexpr int32_t DEFAULT_RESOLUTION_BITS = 10;
+
+    enum class Trigger : uint8_t { Command, Mqtt, Threshold };
+
+    explicit BurstManager(ServiceProvider& serviceProvider);
+
+    BurstManager(const BurstManager&) = delete;
+    BurstManager& operator=(const BurstManager&) = delete;
+
+    void Init();
+
+    /// Start a capture. Returns false if one is already running.
+    bool Start(Trigger source);
+    /// End the running capture early; it is still committed.
+    void Stop();
+    bool IsCapturing();
+
+    /// Write a summary of every stored capture.
+    void WriteList(JsonWriter& json);
+    /// Write the decoded samples of capture `index` (oldest = 0), paged.
+    bool WriteCapture(JsonWriter& json, uint32_t index, uint32_t offset, uint32_t limit);
+
+    bool Erase();
+
+private:
+    enum class BurstKeys : uint8_t { Header, Data };
+
+    struct __attribute__((packed)) BlockHeader
+    {
+        uint32_t startUtc;          // wall-clock time of the first sample
+        uint32_t triggerOffsetMs;   // trigger position relative to the first sample
+        uint32_t durationMs;
+        uint16_t sampleCount;
+        uint8_t slotMask;           // slots valid in any sample
+        uint8_t source;             // Trigger
+        uint8_t resolutionBits;
+    };
+
+    struct Sample
+    {
+        uint32_t uptimeMs;
+        int16_t centi[SLOTS];
+        uint8_t validMask;
+    };
+
+    enum class State : uint8_t { Idle, Capturing, Committing };
+
+    ServiceProvider& serviceProvider_;
+    InitState initState_;
+    mutable Mutex mutex_;           // ring and capture state; taken by the sensor task
+    mutable Mutex flashMutex_;      // log_, held for whole entry writes and reads
+    Task task_;
+
+    EspFlash flash_;
+    FlashLog log_{flash_};
+    bool mounted_ = false;
+
+    Sample* ring_ = nullptr;
+    size_t head_ = 0;           // next write position
+    size_t count_ = 0;
+    uint8_t* encodeBuf_ = nullptr;
+
+    State state_ = State::Idle;
+    Trigger source_ = Trigger::Command;
+    uint32_t triggerMs_ = 0;
+    uint32_t triggerUtc_ = 0;
+    uint32_t endMs_ = 0;
+
+    int32_t preSeconds_ = DEFAULT_PRE_SECONDS;
+    int32_t durationSeconds_ = DEFAULT_DURATION_SECONDS;
+    uint8_t resolutionBits_ = DEFAULT_RESOLUTION_BITS;
+    bool thresholdEnabled_ = false;
+    int32_t thresholdCenti_ = 0;
+    int16_t lastCenti_[SLOTS] = {};
+    uint8_t lastMask_ = 0;
+
+    void OnReading(const SensorSnapshot& snapshot);
+    void Work();
+    void Commit();
+    size_t Encode(size_t first, size_t last, BlockHeader& header);
+
+    static size_t PutVarint(uint8_t* buf, size_t pos, size_t cap, uint32_t value);
+    static bool GetVarint(const uint8_t* buf, size_t len, size_t& pos, uint32_t& value);
+    static uint32_t ZigZag(int32_t v) { return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31); }
+    static int32_t UnZigZag(uint32_t v) { return static_cast<int32_t>(v >> 1) ^ -static_cast<int32_t>(v & 1); }
+};
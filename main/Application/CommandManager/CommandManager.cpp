@@ -8,10 +8,19 @@
 #include "esp_app_desc.h"
 #include "esp_system.h"
 #include "esp_heap_caps.h"
+#include "esp_timer.h"
 #include "NetworkManager.h"
 #include "SensorManager.h"
 #include "LogManager.h"
+#include "HistoryCache.h"
+#include "RollingStats.h"
+#include "MonitorManager.h"
+#include "BurstManager.h"
+#include "AlarmManager.h"
+#include "DisplayManager.h"
+#include "DateTime.h"
 #include <cstring>
+#include <memory>
 
 const CommandManager::CommandEntry CommandManager::commands_[] = {
     { "ping",            &CommandManager::Cmd_Ping,            false },
@@ -24,8 +33,16 @@ const CommandManager::CommandEntry CommandManager::commands_[] = {
     { "wifiScan",        &CommandManager::Cmd_WifiScan,        false },
     { "getLogs",         &CommandManager::Cmd_GetLogs,         false },
     { "getTemperatures", &CommandManager::Cmd_GetTemperatures, false },
+    { "setSensorResolution", &CommandManager::Cmd_SetSensorResolution, true },
     { "getLogEntries",   &CommandManager::Cmd_GetLogEntries,   false },
     { "eraseLog",        &CommandManager::Cmd_EraseLog,        true  },
+    { "getHistory",      &CommandManager::Cmd_GetHistory,      false },
+    { "getStats",        &CommandManager::Cmd_GetStats,        false },
+    { "getMetrics",      &CommandManager::Cmd_GetMetrics,      false },
+    { "burstStart",      &CommandManager::Cmd_BurstStart,      true  },
+    { "burstStop",       &CommandManager::Cmd_BurstStop,       true  },
+    { "getBursts",       &CommandManager::Cmd_GetBursts,       false },
+    { "getBurst",        &CommandManager::Cmd_GetBurst,        false },
     { nullptr, nullptr, false },
 };
 
@@ -212,26 +229,52 @@ void CommandManager::Cmd_GetLogs(const char* json, JsonWriter& resp)
 void CommandManager::Cmd_GetTemperatures(const char* json, JsonWriter& resp)
 {
     auto& sensors = serviceProvider_.getSensorManager();
+    SensorSnapshot snap = sensors.GetSnapshot();
 
+    // Lets a client tell a fresh reading from one it has already seen
+    resp.field("sequence", snap.sequence);
+    resp.field("ageMs", static_cast<uint32_t>((esp_timer_get_time() - snap.timestampUs) / 1000));
+
+    // The four channels always, other ids only when a sensor is assigned
     resp.fieldArray("sensors");
-    for (int i = 0; i < 4; i++)
+    for (int i = 0; i < (int)SensorManager::MAX_SENSORS; i++)
     {
+        if (i >= (int)SensorManager::CHANNEL_COUNT && snap.address[i] == 0 && !snap.IsActive(i))
+            continue;
+
         resp.beginObject();
         resp.field("slot", static_cast<int32_t>(i));
-        resp.field("active", sensors.IsSlotActive(i));
+        resp.field("active", snap.IsActive(i));
 
         char addrBuf[20] = {};
-        uint64_t addr = sensors.GetSlotAddress(i);
-        if (addr != 0)
-            snprintf(addrBuf, sizeof(addrBuf), "%016llX", addr);
+        if (snap.address[i] != 0)
+            snprintf(addrBuf, sizeof(addrBuf), "%016llX", snap.address[i]);
         resp.field("address", addrBuf);
 
-        resp.field("temperature", sensors.IsSlotActive(i) ? sensors.GetTemperature(i) : 0.0f);
+        resp.field("temperature", snap.IsActive(i) ? snap.temperatureC[i] : 0.0f);
+        resp.field("resolution", static_cast<int32_t>(sensors.GetResolution(i)));
         resp.endObject();
     }
     resp.endArray();
 }
 
+void CommandManager::Cmd_SetSensorResolution(const char* json, JsonWriter& resp)
+{
+    int32_t slot = ExtractJsonInt(json, "slot", -1);
+    int32_t bits = ExtractJsonInt(json, "bits", 0);
+    if (slot < 0 || bits == 0)
+    {
+        resp.field("ok", false);
+        resp.field("error", "Missing slot or bits");
+        return;
+    }
+
+    bool ok = serviceProvider_.getSensorManager().SetResolution(slot, static_cast<uint8_t>(bits));
+    resp.field("ok", ok);
+    if (!ok)
+        resp.field("error", "Invalid slot or resolution");
+}
+
 void CommandManager::Cmd_GetLogEntries(const char* json, JsonWriter& resp)
 {
     auto& logManager = serviceProvider_.getLogManager();
@@ -239,8 +282,8 @@ void CommandManager::Cmd_GetLogEntries(const char* json, JsonWriter& resp)
 
     int32_t offset = 0;
     int32_t limit = 50;
-    ExtractJsonInt(json, "offset", offset);
-    ExtractJsonInt(json, "limit", limit);
+    offset = ExtractJsonInt(json, "offset", offset);
+    limit = ExtractJsonInt(json, "limit", limit);
     if (offset < 0) offset = 0;
     if (limit < 1) limit = 1;
     if (limit > 200) limit = 200;
@@ -277,6 +320,276 @@ void CommandManager::Cmd_GetLogEntries(const char* json, JsonWriter& resp)
 void CommandManager::Cmd_EraseLog(const char* json, JsonWriter& resp)
 {
     bool ok = serviceProvider_.getLogManager().Erase();
+    ok = serviceProvider_.getBurstManager().Erase() && ok;
+    resp.field("ok", ok);
+}
+
+
+// Each point: [ts, count, avg0, min0, max0, ... avg3, min3, max3] in centi-°C.
+// 120 points stays well inside the 16 KB websocket response buffer.
+static constexpr int32_t HISTORY_MAX_POINTS = 120;
+
+static void WriteHistoryPoint(JsonWriter& resp, const TemperaturePoint& point)
+{
+    resp.beginArray();
+    resp.value(point.timestamp);
+    resp.value(point.count);
+    for (size_t s = 0; s < TemperaturePoint::MAX_SLOTS; s++)
+    {
+        if (!point.IsValid(s))
+        {
+            resp.nullValue().nullValue().nullValue();
+            continue;
+        }
+        resp.value(static_cast<int32_t>(point.avg[s]));
+        resp.value(static_cast<int32_t>(point.min[s]));
+        resp.value(static_cast<int32_t>(point.max[s]));
+    }
+    resp.endArray();
+}
+
+void CommandManager::Cmd_GetHistory(const char* json, JsonWriter& resp)
+{
+    auto& logManager = serviceProvider_.getLogManager();
+
+    int32_t from = 0;
+    int32_t to = static_cast<int32_t>(DateTime::Now().UtcSeconds());
+    int32_t resolution = 0;
+    int32_t limit = HISTORY_MAX_POINTS;
+    from = ExtractJsonInt(json, "from", from);
+    to = ExtractJsonInt(json, "to", to);
+    resolution = ExtractJsonInt(json, "resolution", resolution);
+    limit = ExtractJsonInt(json, "limit", limit);
+    if (limit < 1) limit = 1;
+    if (limit > HISTORY_MAX_POINTS) limit = HISTORY_MAX_POINTS;
+
+    if (from < 0 || to <= from)
+    {
+        resp.field("ok", false);
+        resp.field("error", "range");
+        return;
+    }
+
+    // Never return more than `limit` buckets for the requested span
+    int32_t span = to - from;
+    int32_t minResolution = (span + limit - 1) / limit;
+    if (resolution < minResolution) resolution = minResolution;
+    if (resolution < 1) resolution = 1;
+
+    resp.field("from", from);
+    resp.field("to", to);
+    resp.field("resolution", resolution);
+
+    // RAM cache first — no flash access and no log mutex
+    auto cached = std::make_unique<TemperaturePoint[]>(limit);
+    size_t cachedCount = 0;
+    if (serviceProvider_.getHistoryCache().Query(from, to, resolution, cached.get(), limit, cachedCount))
+    {
+        resp.field("source", "cache");
+        resp.fieldArray("points");
+        for (size_t i = 0; i < cachedCount; i++)
+            WriteHistoryPoint(resp, cached[i]);
+        resp.endArray();
+        return;
+    }
+    cached.reset();
+
+    LogManager::RollupTier tier;
+    bool useRollup = logManager.SelectRollupTier(static_cast<uint32_t>(resolution), tier);
+
+    static constexpr const char* tierNames[] = { "minute", "hour", "day" };
+    resp.field("source", useRollup ? tierNames[static_cast<size_t>(tier)] : "raw");
+    resp.fieldArray("points");
+
+    TemperaturePoint bucket;
+    int32_t emitted = 0;
+
+    auto addPoint = [&](TemperaturePoint point) {
+        uint32_t ts = point.timestamp;
+        if (ts < static_cast<uint32_t>(from)) return true;
+        if (ts >= static_cast<uint32_t>(to)) return false;
+
+        uint32_t bucketStart = from + ((ts - from) / resolution) * resolution;
+        if (bucket.count > 0 && bucket.timestamp != bucketStart)
+        {
+            WriteHistoryPoint(resp, bucket);
+            if (++emitted >= limit) return false;
+            bucket = TemperaturePoint{};
+        }
+
+        point.timestamp = bucketStart;
+        bucket.Merge(point);
+        return true;
+    };
+
+    if (useRollup)
+    {
+        LogManager::ForEachChronological(logManager.ReadRollup(tier), [&](const EntryIterator& entry) {
+            TemperaturePoint point;
+            if (!LogManager::DecodeTemperaturePoint(entry, point))
+                return true;
+            return addPoint(point);
+        });
+    }
+    else
+    {
+        // The raw log is change-driven; rebuild the step-wise series on the sample grid
+        auto& monitor = serviceProvider_.getMonitorManager();
+        uint32_t rate = monitor.GetRateSeconds();
+        LogManager::ForEachReconstructed(logManager.Read(), rate, monitor.GetHeartbeatSeconds() + rate, addPoint);
+    }
+
+    if (bucket.count > 0 && emitted < limit)
+        WriteHistoryPoint(resp, bucket);
+
+    resp.endArray();
+}
+
+void CommandManager::Cmd_GetStats(const char* json, JsonWriter& resp)
+{
+    auto& stats = serviceProvider_.getRollingStats();
+
+    resp.fieldArray("windows");
+    for (const auto& window : RollingStats::WINDOWS)
+        resp.value(window.name);
+    resp.endArray();
+
+    // One object per channel, keyed by window name; null until the window has data
+    resp.fieldArray("slots");
+    for (size_t slot = 0; slot < RollingStats::SLOTS; slot++)
+    {
+        resp.beginObject();
+        resp.field("slot", static_cast<int32_t>(slot));
+        for (size_t w = 0; w < RollingStats::WINDOW_COUNT; w++)
+        {
+            RollingStats::Stats s;
+            if (!stats.Get(slot, w, s))
+            {
+                resp.nullField(RollingStats::WINDOWS[w].name);
+                continue;
+            }
+            resp.fieldObject(RollingStats::WINDOWS[w].name);
+            resp.field("count", s.count);
+            resp.field("min", s.min);
+            resp.field("max", s.max);
+            resp.field("mean", s.mean);
+            resp.field("stddev", s.stddev);
+            resp.endObject();
+        }
+        resp.endObject();
+    }
+    resp.endArray();
+}
+
+void CommandManager::Cmd_GetMetrics(const char* json, JsonWriter& resp)
+{
+    auto& monitor = serviceProvider_.getMonitorManager();
+    auto sampler = monitor.GetSamplerStats();
+
+    resp.fieldObject("sampler");
+    resp.field("rate", monitor.GetRateSeconds());
+    resp.field("samples", sampler.samples);
+    resp.field("missedDeadlines", sampler.missedDeadlines);
+    resp.field("lastLatenessMs", sampler.lastLatenessMs);
+    resp.field("maxLatenessMs", sampler.maxLatenessMs);
+    resp.field("staleSamples", sampler.staleSamples);
+    resp.field("clockSteps", sampler.clockSteps);
+    resp.field("entriesWritten", sampler.entriesWritten);
+    resp.field("slotsSuppressed", sampler.slotsSuppressed);
+    resp.endObject();
+
+    auto& sensors = serviceProvider_.getSensorManager();
+    resp.fieldObject("sensors");
+    resp.field("cycleUs", sensors.GetLastCycleUs());
+    resp.fieldArray("buses");
+    for (size_t b = 0; b < SensorManager::BUS_COUNT; b++)
+    {
+        auto bus = sensors.GetBusStats(b);
+        resp.beginObject();
+        resp.field("gpio", static_cast<int32_t>(bus.gpio));
+        resp.field("sensors", bus.sensors);
+        resp.field("lastReadUs", bus.lastReadUs);
+        resp.field("maxReadUs", bus.maxReadUs);
+        resp.field("errors", bus.errors);
+        resp.field("searches", bus.searches);
+        resp.field("rejected", bus.rejected);
+        resp.endObject();
+    }
+    resp.endArray();
+    resp.endObject();
+
+    auto& alarms = serviceProvider_.getAlarmManager();
+    auto alarmStats = alarms.GetStats();
+    resp.fieldObject("alarms");
+    resp.field("activeMask", alarms.GetActiveMask());
+    resp.field("raised", alarmStats.raised);
+    resp.field("cleared", alarmStats.cleared);
+    resp.field("dropped", alarmStats.dropped);
+    resp.field("lastLatencyUs", alarmStats.lastLatencyUs);
+    resp.field("maxLatencyUs", alarmStats.maxLatencyUs);
+    resp.endObject();
+
+    auto display = serviceProvider_.getDisplayManager().GetStats();
+    resp.fieldObject("display");
+    resp.field("fps", display.fps);
+    resp.field("frameCpuUs", display.frameCpuUs);
+    resp.field("frameBlockedUs", display.frameBlockedUs);
+    resp.field("bufferLines", display.bufferLines);
+    resp.field("bufferInPsram", display.bufferInPsram);
+    resp.field("taskLoadPct", display.taskLoadPct);
+    resp.field("wakeups", display.wakeups);
+    resp.field("screen", DisplayManager::ScreenName(display.screen));
+    resp.field("touchIrqs", display.touchIrqs);
+    resp.field("touchReads", display.touchReads);
+    resp.field("navigations", display.navigations);
+    resp.field("lastNavigateUs", display.lastNavigateUs);
+    resp.field("maxNavigateUs", display.maxNavigateUs);
+    resp.field("pagesCreated", display.pagesCreated);
+    resp.field("pagesReused", display.pagesReused);
+    resp.field("pagesEvicted", display.pagesEvicted);
+    resp.field("lvglMemFree", display.lvglMemFree);
+    resp.field("lvglMemBiggest", display.lvglMemBiggest);
+    resp.field("lvglMemFragPct", static_cast<uint32_t>(display.lvglMemFragPct));
+    resp.endObject();
+}
+
+void CommandManager::Cmd_BurstStart(const char* json, JsonWriter& resp)
+{
+    bool ok = serviceProvider_.getBurstManager().Start(BurstManager::Trigger::Command);
     resp.field("ok", ok);
+    if (!ok)
+        resp.field("error", "busy");
+}
+
+void CommandManager::Cmd_BurstStop(const char* json, JsonWriter& resp)
+{
+    serviceProvider_.getBurstManager().Stop();
+    resp.field("ok", true);
 }
 
+void CommandManager::Cmd_GetBursts(const char* json, JsonWriter& resp)
+{
+    auto& burst = serviceProvider_.getBurstManager();
+    resp.field("capturing", burst.IsCapturing());
+    burst.WriteList(resp);
+}
+
+void CommandManager::Cmd_GetBurst(const char* json, JsonWriter& resp)
+{
+    int32_t index = 0;
+    int32_t offset = 0;
+    int32_t limit = 200;
+    index = ExtractJsonInt(json, "index", index);
+    offset = ExtractJsonInt(json, "offset", offset);
+    limit = ExtractJsonInt(json, "limit", limit);
+    if (index < 0) index = 0;
+    if (offset < 0) offset = 0;
+    if (limit < 1) limit = 1;
+    if (limit > 200) limit = 200;
+
+    if (!serviceProvider_.getBurstManager().WriteCapture(resp, index, offset, limit))
+    {
+        resp.field("ok", false);
+        resp.field("error", "not found");
+    }
+}
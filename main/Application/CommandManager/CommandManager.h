@@ -49,6 +49,14 @@ private:
     void Cmd_WifiScan(const char* json, JsonWriter& resp);
     void Cmd_GetLogs(const char* json, JsonWriter& resp);
     void Cmd_GetTemperatures(const char* json, JsonWriter& resp);
+    void Cmd_SetSensorResolution(const char* json, JsonWriter& resp);
     void Cmd_GetLogEntries(const char* json, JsonWriter& resp);
     void Cmd_EraseLog(const char* json, JsonWriter& resp);
+    void Cmd_GetHistory(const char* json, JsonWriter& resp);
+    void Cmd_GetStats(const char* json, JsonWriter& resp);
+    void Cmd_GetMetrics(const char* json, JsonWriter& resp);
+    void Cmd_BurstStart(const char* json, JsonWriter& resp);
+    void Cmd_BurstStop(const char* json, JsonWriter& resp);
+    void Cmd_GetBursts(const char* json, JsonWriter& resp);
+    void Cmd_GetBurst(const char* json, JsonWriter& resp);
 };
@@ -0,0 +1,13 @@
+#pragma once
+#include "lvgl.h"
+#include "SensorManager/SensorManager.h"
+
+// Colour and name of each channel (sensor ids 0..CHANNEL_COUNT-1), shared by
+// the home and history charts and the new-sensor popup
+inline const lv_color_t CHANNEL_COLORS[SensorManager::CHANNEL_COUNT] = {
+    lv_palette_main(LV_PALETTE_RED),
+    lv_palette_main(LV_PALETTE_BLUE),
+    lv_palette_main(LV_PALETTE_GREEN),
+    lv_palette_main(LV_PALETTE_YELLOW)
+};
+inline const char *const CHANNEL_NAMES[SensorManager::CHANNEL_COUNT] = {"Red", "Blue", "Green", "Yellow"};
@@ -1,31 +1,45 @@
 #include "DisplayManager.h"
+#include "ChannelColors.h"
+#include "esp_heap_caps.h"
 #include <algorithm>
 #include <cinttypes>
 #include <cstring>
 
-static const lv_color_t channelColors[4] = {
-    lv_palette_main(LV_PALETTE_RED),
-    lv_palette_main(LV_PALETTE_BLUE),
-    lv_palette_main(LV_PALETTE_GREEN),
-    lv_palette_main(LV_PALETTE_YELLOW)
-};
-static const char *slotNames[4] = {"Red", "Blue", "Green", "Yellow"};
+// Free bytes, largest free block and fragmentation of the heap LVGL allocates from
+static void LvglMemory(uint32_t &freeBytes, uint32_t &biggest, uint8_t &fragPct)
+{
+#if LV_MEM_CUSTOM == 0
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    freeBytes = mon.free_size;
+    biggest = mon.free_biggest_size;
+    fragPct = mon.frag_pct;
+#else
+    freeBytes = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    biggest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    fragPct = freeBytes ? static_cast<uint8_t>(100 - (uint64_t)biggest * 100 / freeBytes) : 0;
+#endif
+}
 
 DisplayManager::DisplayManager(ServiceProvider &ctx)
     : sensorManager(ctx.getSensorManager())
-    , homePage(ctx.getNetworkManager(), ctx.getSensorManager(), ctx.getSettingsManager())
+    , settingsManager(ctx.getSettingsManager())
+    , homePage(ctx.getNetworkManager(), ctx.getSensorManager(), ctx.getSettingsManager(), ctx.getRollingStats(),
+               ctx.getHistoryCache())
     , wifiPage(ctx.getSettingsManager(), ctx.getNetworkManager())
     , sensorPage(ctx.getSettingsManager(), ctx.getSensorManager())
     , graphPage(ctx.getSettingsManager())
     , systemPage(ctx.getSettingsManager())
+    , historyPage(ctx.getHistoryCache(), display)
 {
+    DisplayPage *all[PAGE_COUNT] = {&homePage, &settingsMenuPage, &wifiPage, &sensorPage,
+                                    &graphPage, &systemPage, &historyPage};
     auto nav = [this](const char *page) { NavigateTo(page); };
-    homePage.SetNavigator(nav);
-    settingsMenuPage.SetNavigator(nav);
-    wifiPage.SetNavigator(nav);
-    sensorPage.SetNavigator(nav);
-    graphPage.SetNavigator(nav);
-    systemPage.SetNavigator(nav);
+    for (size_t i = 0; i < PAGE_COUNT; i++)
+    {
+        pages[i] = all[i];
+        pages[i]->SetNavigator(nav);
+    }
 }
 
 void DisplayManager::Init()
@@ -39,6 +53,9 @@ void DisplayManager::Init()
     lv_init();
     display.Init();
 
+#if !LV_TICK_CUSTOM
+    // Without LV_TICK_CUSTOM (which reads esp_timer directly) LVGL needs a
+    // periodic tick, and the CPU wakes for it every 5 ms
     const esp_timer_create_args_t tickTimerArgs = {
         .callback = LvglTickCb,
         .arg = nullptr,
@@ -48,10 +65,24 @@ void DisplayManager::Init()
     };
     ESP_ERROR_CHECK(esp_timer_create(&tickTimerArgs, &lvglTickTimer));
     ESP_ERROR_CHECK(esp_timer_start_periodic(lvglTickTimer, 5000));
+#endif
+
+    LoadScreenConfig();
+    display.SetBrightness(onPercent);
+    lastActivityUs = esp_timer_get_time();
 
     task.Init("DisplayTask", 5, 4096);
     task.SetHandler([this]() { Work(); });
     task.Run();
+    sensorManager.Subscribe(task, NOTIFY_READING);
+    sensorManager.SubscribePending(task, NOTIFY_PENDING);
+
+    // Touch input is event driven; the interrupt wakes the task
+    display.SetTouchWakeHandler([](void *ctx) {
+        BaseType_t woken = pdFALSE;
+        static_cast<Task *>(ctx)->NotifyFromISR(NOTIFY_TOUCH, &woken);
+        portYIELD_FROM_ISR(woken);
+    }, &task);
 
     init.SetReady();
     ESP_LOGI(TAG, "DisplayManager initialized successfully.");
@@ -62,39 +93,181 @@ void DisplayManager::Work()
     NavigateTo("home");
 
     uint32_t delayMs;
+    uint32_t notified = 0;
     TickType_t lastUpdate = xTaskGetTickCount();
+    int64_t handlerUs = 0;
+    int64_t busyUs = 0;
+    uint32_t wakeups = 0;
+    int64_t statsStartUs = esp_timer_get_time();
+    Display_WT32SC01::Counters lastCounters = display.GetCounters();
 
     while (true)
     {
-        delayMs = lv_timer_handler();
+        int64_t wokeUs = esp_timer_get_time();
+        wakeups++;
+
+        if (notified & NOTIFY_TOUCH)
+            WakeScreen();
+
+        // Readings are pushed once per sensor cycle, not polled. With the
+        // screen off the widgets are still updated, just not rendered.
+        if ((notified & NOTIFY_READING) && activePage)
+            activePage->OnReadings(sensorManager.GetSnapshot());
+        if (notified & NOTIFY_PENDING)
+            OfferPendingSensor();
+        // Also catches an interrupt that came before the wake handler was set
+        display.ServiceTouch();
+
+        delayMs = LV_NO_TIMER_READY;
+        if (screen != Screen::Off)
+        {
+            int64_t handlerStart = esp_timer_get_time();
+            delayMs = lv_timer_handler();
+            handlerUs += esp_timer_get_time() - handlerStart;
+            if (navigateStartUs)
+                OnNavigateFrame();
+        }
 
         if (xTaskGetTickCount() - lastUpdate > pdMS_TO_TICKS(1000))
         {
             lastUpdate = xTaskGetTickCount();
 
+            int64_t now = esp_timer_get_time();
+            busyUs += now - wokeUs;
+            wokeUs = now;
+            UpdateStats(handlerUs, busyUs, wakeups, lastCounters, now - statsStartUs);
+            handlerUs = 0;
+            busyUs = 0;
+            wakeups = 0;
+            statsStartUs = now;
+
+            UpdateScreen();
             if (activePage)
                 activePage->Update();
+        }
 
-            // Sensor assignment popup (only on home page)
-            if (activePage == &homePage && !assignPopup && sensorManager.HasPendingSensor())
-                ShowAssignPopup(sensorManager.GetPendingSensorAddress());
+        // Touch, readings and new sensors wake the task, so idle it only has
+        // to be back for the next LVGL timer or the once-a-second update
+        uint32_t sinceUpdateMs = pdTICKS_TO_MS(xTaskGetTickCount() - lastUpdate);
+        uint32_t untilUpdateMs = sinceUpdateMs < 1000 ? 1000 - sinceUpdateMs : 0;
+        busyUs += esp_timer_get_time() - wokeUs;
+        notified = 0;
+        task.NotifyWait(&notified, pdMS_TO_TICKS(std::clamp(std::min(delayMs, untilUpdateMs), (uint32_t)5, (uint32_t)1000)));
+    }
+}
 
-            if (assignPopup && (xTaskGetTickCount() - popupShownAt > POPUP_TIMEOUT))
-                AutoAssignToFirstEmpty();
-        }
+void DisplayManager::UpdateStats(int64_t handlerUs, int64_t busyUs, uint32_t wakeups,
+                                 Display_WT32SC01::Counters &last, int64_t elapsedUs)
+{
+    auto counters = display.GetCounters();
+    uint32_t frames = counters.frames - last.frames;
+    int64_t blockedUs = counters.blockedUs - last.blockedUs;
+    last = counters;
+
+    uint32_t memFree = 0, memBiggest = 0;
+    uint8_t memFrag = 0;
+    LvglMemory(memFree, memBiggest, memFrag);
+
+    LOCK(statsMutex);
+    stats.lvglMemFree = memFree;
+    stats.lvglMemBiggest = memBiggest;
+    stats.lvglMemFragPct = memFrag;
+    stats.fps = elapsedUs > 0 ? static_cast<uint32_t>((frames * 1000000LL + elapsedUs / 2) / elapsedUs) : 0;
+    stats.frameCpuUs = frames ? static_cast<uint32_t>(std::max<int64_t>(handlerUs - blockedUs, 0) / frames) : 0;
+    stats.frameBlockedUs = frames ? static_cast<uint32_t>(blockedUs / frames) : 0;
+    stats.taskLoadPct = elapsedUs > 0 ? busyUs * 100.0f / elapsedUs : 0.0f;
+    stats.wakeups = elapsedUs > 0 ? static_cast<uint32_t>((wakeups * 1000000LL + elapsedUs / 2) / elapsedUs) : 0;
+    stats.screen = screen;
+    stats.touchIrqs = counters.touchIrqs;
+    stats.touchReads = counters.touchReads;
+    stats.bufferLines = display.GetBufferLines();
+    stats.bufferInPsram = display.IsBufferInPsram();
+}
 
-        vTaskDelay(pdMS_TO_TICKS(std::clamp(delayMs, (uint32_t)5, (uint32_t)100)));
+DisplayManager::Stats DisplayManager::GetStats()
+{
+    LOCK(statsMutex);
+    return stats;
+}
+
+const char *DisplayManager::ScreenName(Screen screen)
+{
+    switch (screen)
+    {
+    case Screen::On:  return "on";
+    case Screen::Dim: return "dim";
+    case Screen::Off: return "off";
     }
+    return "unknown";
 }
 
+#if !LV_TICK_CUSTOM
 void DisplayManager::LvglTickCb(void *arg)
 {
     (void)arg;
     lv_tick_inc(5);
 }
+#endif
+
+// ── Screen saver ─────────────────────────────────────────────
+
+void DisplayManager::LoadScreenConfig()
+{
+    dimSeconds = settingsManager.getInt("display.dim", 0);
+    offSeconds = settingsManager.getInt("display.off", 0);
+    dimPercent = std::clamp<int32_t>(settingsManager.getInt("display.dimpct", 20), 1, 100);
+
+    // A changed brightness shows right away unless the screen is dimmed
+    int32_t bright = std::clamp<int32_t>(settingsManager.getInt("display.bright", 50), 1, 100);
+    if (bright != onPercent && screen == Screen::On)
+        display.SetBrightness(bright);
+    onPercent = bright;
+}
+
+void DisplayManager::UpdateScreen()
+{
+    if (++screenConfigAge >= SCREEN_CONFIG_RELOAD_S)
+    {
+        screenConfigAge = 0;
+        LoadScreenConfig();
+    }
+
+    int64_t idleS = (esp_timer_get_time() - lastActivityUs) / 1000000;
+    Screen target = Screen::On;
+    if (offSeconds > 0 && idleS >= offSeconds)
+        target = Screen::Off;
+    else if (dimSeconds > 0 && idleS >= dimSeconds)
+        target = Screen::Dim;
+
+    // Only the touch wakes the screen; an idle timer never brightens it
+    if (target <= screen)
+        return;
+
+    screen = target;
+    display.SetBrightness(screen == Screen::Off ? 0 : dimPercent);
+    ESP_LOGI(TAG, "Screen %s", ScreenName(screen));
+}
+
+void DisplayManager::WakeScreen()
+{
+    lastActivityUs = esp_timer_get_time();
+    if (screen == Screen::On)
+        return;
+
+    // The touch that wakes a dark screen must not also press a button
+    if (screen == Screen::Off)
+        display.IgnoreUntilRelease();
+    screen = Screen::On;
+    display.SetBrightness(onPercent);
+    ESP_LOGI(TAG, "Screen on");
+}
 
 void DisplayManager::NavigateTo(const char *page)
 {
+    // Timed until the first frame of the new page is out (OnNavigateFrame)
+    navigateStartUs = esp_timer_get_time();
+    navigateFrames = display.GetCounters().frames;
+
     CloseAssignPopup();
 
     DisplayPage *previousPage = activePage;
@@ -107,8 +280,8 @@ void DisplayManager::NavigateTo(const char *page)
 
     if (strcmp(page, "back") == 0)
     {
-        // Back from sub-pages → settings menu, back from menu → home
-        if (previousPage == &settingsMenuPage)
+        // Back from sub-pages → settings menu, back from menu or history → home
+        if (previousPage == &settingsMenuPage || previousPage == &historyPage)
             activePage = &homePage;
         else
             activePage = &settingsMenuPage;
@@ -125,22 +298,104 @@ void DisplayManager::NavigateTo(const char *page)
         activePage = &graphPage;
     else if (strcmp(page, "system") == 0)
         activePage = &systemPage;
+    else if (strcmp(page, "history") == 0)
+        activePage = &historyPage;
     else
         activePage = &homePage;
 
     if (activePage)
+    {
+        bool reused = activePage->IsCreated();
         activePage->Show(lv_scr_act());
+        activePage->OnReadings(sensorManager.GetSnapshot());
+
+        for (size_t i = 0; i < PAGE_COUNT; i++)
+            if (pages[i] == activePage)
+                pageLastShown[i] = ++navigateSeq;
+
+        {
+            LOCK(statsMutex);
+            if (reused)
+                stats.pagesReused++;
+            else
+                stats.pagesCreated++;
+        }
+
+        // Sensors found while another page was open are offered on return
+        OfferPendingSensor();
+    }
+
+    EvictIdlePages();
+}
+
+void DisplayManager::EvictIdlePages()
+{
+    // Least recently shown first, never the page on screen
+    while (true)
+    {
+        uint32_t memFree = 0, memBiggest = 0;
+        uint8_t memFrag = 0;
+        LvglMemory(memFree, memBiggest, memFrag);
+        if (memFree >= LVGL_MEM_LOW_WATER)
+            return;
+
+        DisplayPage *victim = nullptr;
+        uint32_t oldest = UINT32_MAX;
+        for (size_t i = 0; i < PAGE_COUNT; i++)
+        {
+            if (pages[i] == activePage || !pages[i]->IsCreated() || pageLastShown[i] >= oldest)
+                continue;
+            victim = pages[i];
+            oldest = pageLastShown[i];
+        }
+        if (!victim)
+            return;
+
+        victim->Evict();
+        ESP_LOGI(TAG, "Evicted a hidden page (LVGL free %lu bytes)", (unsigned long)memFree);
+        LOCK(statsMutex);
+        stats.pagesEvicted++;
+    }
+}
+
+void DisplayManager::OnNavigateFrame()
+{
+    if (display.GetCounters().frames == navigateFrames)
+        return;
+
+    uint32_t elapsedUs = static_cast<uint32_t>(esp_timer_get_time() - navigateStartUs);
+    navigateStartUs = 0;
+
+    LOCK(statsMutex);
+    stats.navigations++;
+    stats.lastNavigateUs = elapsedUs;
+    if (elapsedUs > stats.maxNavigateUs)
+        stats.maxNavigateUs = elapsedUs;
 }
 
 // ── Assignment popup ─────────────────────────────────────────
 
+void DisplayManager::OfferPendingSensor()
+{
+    // Only on the home page, one at a time; wakes the screen
+    if (activePage != &homePage || assignPopup)
+        return;
+
+    uint64_t address = sensorManager.GetPendingSensorAddress();
+    if (address == 0)
+        return;
+
+    WakeScreen();
+    ShowAssignPopup(address);
+}
+
 void DisplayManager::ShowAssignPopup(uint64_t address)
 {
     if (assignPopup)
         return;
 
     popupSensorAddress = address;
-    popupShownAt = xTaskGetTickCount();
+    popupTimer = lv_timer_create(PopupTimeoutCb, POPUP_TIMEOUT_MS, this);
 
     assignPopup = lv_obj_create(lv_scr_act());
     lv_obj_set_size(assignPopup, LCD_HRES, LCD_VRES);
@@ -170,16 +425,19 @@ void DisplayManager::ShowAssignPopup(uint64_t address)
     lv_obj_set_style_text_color(subtitle, lv_color_white(), LV_PART_MAIN);
     lv_obj_align(subtitle, LV_ALIGN_TOP_MID, 0, 75);
 
-    static constexpr lv_coord_t btnW = 100, btnH = 60, btnGap = 12;
-    lv_coord_t totalW = 4 * btnW + 3 * btnGap;
+    // One button per colour channel, plus "Other" for the next free id past them
+    static constexpr int btnCount = SensorManager::CHANNEL_COUNT + 1;
+    static constexpr lv_coord_t btnW = 80, btnH = 60, btnGap = 12;
+    lv_coord_t totalW = btnCount * btnW + (btnCount - 1) * btnGap;
     lv_coord_t startX = (LCD_HRES - totalW) / 2;
 
-    for (int i = 0; i < 4; i++)
+    for (int i = 0; i < btnCount; i++)
     {
+        bool other = i == (int)SensorManager::CHANNEL_COUNT;
         lv_obj_t *btn = lv_btn_create(assignPopup);
         lv_obj_set_size(btn, btnW, btnH);
         lv_obj_set_pos(btn, startX + i * (btnW + btnGap), 110);
-        lv_obj_set_style_bg_color(btn, channelColors[i], LV_PART_MAIN);
+        lv_obj_set_style_bg_color(btn, other ? lv_palette_main(LV_PALETTE_GREY) : CHANNEL_COLORS[i], LV_PART_MAIN);
         lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, LV_PART_MAIN);
         lv_obj_set_style_radius(btn, 10, LV_PART_MAIN);
         lv_obj_set_style_border_width(btn, 2, LV_PART_MAIN);
@@ -187,13 +445,13 @@ void DisplayManager::ShowAssignPopup(uint64_t address)
         lv_obj_set_style_shadow_width(btn, 0, LV_PART_MAIN);
 
         lv_obj_t *label = lv_label_create(btn);
-        lv_label_set_text(label, slotNames[i]);
+        lv_label_set_text(label, other ? "Other" : CHANNEL_NAMES[i]);
         lv_obj_set_style_text_color(label, lv_color_white(), LV_PART_MAIN);
         lv_obj_set_style_text_font(label, &lv_font_montserrat_14, LV_PART_MAIN);
         lv_obj_center(label);
 
         lv_obj_set_user_data(btn, this);
-        lv_obj_add_event_cb(btn, PopupEventCb, LV_EVENT_CLICKED, reinterpret_cast<void *>(i));
+        lv_obj_add_event_cb(btn, PopupEventCb, LV_EVENT_CLICKED, (void *)(intptr_t)i);
     }
 
     lv_obj_t *hint = lv_label_create(assignPopup);
@@ -205,6 +463,11 @@ void DisplayManager::ShowAssignPopup(uint64_t address)
 
 void DisplayManager::CloseAssignPopup()
 {
+    if (popupTimer)
+    {
+        lv_timer_del(popupTimer);
+        popupTimer = nullptr;
+    }
     if (assignPopup)
     {
         lv_obj_del(assignPopup);
@@ -215,17 +478,19 @@ void DisplayManager::CloseAssignPopup()
 
 void DisplayManager::OnSlotSelected(int slot)
 {
-    if (slot < 0 || slot >= 4)
+    if (slot < 0 || slot >= (int)SensorManager::MAX_SENSORS)
         return;
     sensorManager.AssignPendingToSlot(slot);
     CloseAssignPopup();
+    OfferPendingSensor();
 }
 
-void DisplayManager::AutoAssignToFirstEmpty()
+void DisplayManager::AssignToFirstEmpty(int firstSlot)
 {
-    for (int i = 0; i < 4; i++)
+    SensorSnapshot snap = sensorManager.GetSnapshot();
+    for (int i = firstSlot; i < (int)SensorManager::MAX_SENSORS; i++)
     {
-        if (sensorManager.GetSlotAddress(i) == 0)
+        if (snap.address[i] == 0)
         {
             OnSlotSelected(i);
             return;
@@ -233,13 +498,24 @@ void DisplayManager::AutoAssignToFirstEmpty()
     }
     sensorManager.DismissPendingSensor();
     CloseAssignPopup();
+    OfferPendingSensor();
 }
 
 void DisplayManager::PopupEventCb(lv_event_t *e)
 {
-    int slot = reinterpret_cast<int>(lv_event_get_user_data(e));
+    int slot = (int)(intptr_t)lv_event_get_user_data(e);
     lv_obj_t *btn = lv_event_get_target(e);
     auto *self = static_cast<DisplayManager *>(lv_obj_get_user_data(btn));
-    if (self && slot >= 0 && slot < 4)
+    if (!self)
+        return;
+    if (slot == (int)SensorManager::CHANNEL_COUNT)
+        self->AssignToFirstEmpty(slot);
+    else if (slot >= 0 && slot < (int)SensorManager::CHANNEL_COUNT)
         self->OnSlotSelected(slot);
 }
+
+void DisplayManager::PopupTimeoutCb(lv_timer_t *timer)
+{
+    // Deleted by CloseAssignPopup, which LVGL allows from the timer's own callback
+    static_cast<DisplayManager *>(timer->user_data)->AssignToFirstEmpty(0);
+}
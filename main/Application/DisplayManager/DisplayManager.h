@@ -12,24 +12,74 @@
 #include "SensorPage.h"
 #include "GraphPage.h"
 #include "SystemPage.h"
+#include "HistoryPage.h"
 
 class DisplayManager
 {
     inline static constexpr const char *TAG = "DisplayManager";
     static constexpr int LCD_HRES = 480;
     static constexpr int LCD_VRES = 320;
-    static constexpr TickType_t POPUP_TIMEOUT = pdMS_TO_TICKS(30000);
+    static constexpr uint32_t POPUP_TIMEOUT_MS = 30000;
+    static constexpr uint32_t NOTIFY_READING = 1u << 0;
+    static constexpr uint32_t NOTIFY_TOUCH = 1u << 1;
+    static constexpr uint32_t NOTIFY_PENDING = 1u << 2;     // a new sensor awaits assignment
+    static constexpr size_t PAGE_COUNT = 7;
+    static constexpr uint32_t LVGL_MEM_LOW_WATER = 8 * 1024;   // evict hidden pages below this
+    static constexpr uint32_t SCREEN_CONFIG_RELOAD_S = 5;
+
+    // host/bench drives navigation and frames itself instead of Work()
+    friend class UiBench;
 
 public:
+    /// Backlight state; Off also stops rendering until the next touch.
+    enum class Screen : uint8_t { On, Dim, Off };
+
+    /// Rendering load over the last second.
+    struct Stats
+    {
+        uint32_t fps;
+        uint32_t frameCpuUs;        // LVGL time per frame, minus time blocked on the panel
+        uint32_t frameBlockedUs;    // time per frame in flush_cb or waiting for the DMA
+        int32_t bufferLines;
+        bool bufferInPsram;
+        float taskLoadPct;          // display task busy time, percent of one core
+        uint32_t wakeups;           // display task wake-ups per second
+        Screen screen;
+        uint32_t touchIrqs;         // since boot
+        uint32_t touchReads;        // I2C reads of the touch controller, since boot
+
+        // Navigation, from the request to the first frame of the new page
+        uint32_t navigations;
+        uint32_t lastNavigateUs;
+        uint32_t maxNavigateUs;
+        uint32_t pagesCreated;      // Show that had to build the widgets
+        uint32_t pagesReused;       // Show that only unhid them
+        uint32_t pagesEvicted;
+
+        // LVGL heap
+        uint32_t lvglMemFree;
+        uint32_t lvglMemBiggest;    // largest free block
+        uint8_t lvglMemFragPct;
+    };
+
     explicit DisplayManager(ServiceProvider &ctx);
     void Init();
 
+    Stats GetStats();
+
+    static const char *ScreenName(Screen screen);
+
 private:
     SensorManager &sensorManager;
+    SettingsManager &settingsManager;
     InitState initState;
     Display_WT32SC01 display;
     Task task;
+#if !LV_TICK_CUSTOM
     esp_timer_handle_t lvglTickTimer = nullptr;
+#endif
+    Mutex statsMutex;
+    Stats stats = {};
 
     // Pages
     HomePage homePage;
@@ -38,21 +88,50 @@ private:
     SensorPage sensorPage;
     GraphPage graphPage;
     SystemPage systemPage;
+    HistoryPage historyPage;
     DisplayPage *activePage = nullptr;
 
-    // Sensor assignment popup
+    // Built pages stay hidden between visits; the least recently shown are
+    // deleted when LVGL runs low on memory
+    DisplayPage *pages[PAGE_COUNT] = {};
+    uint32_t pageLastShown[PAGE_COUNT] = {};
+    uint32_t navigateSeq = 0;
+    int64_t navigateStartUs = 0;    // pending until the next frame completes
+    uint32_t navigateFrames = 0;
+
+    // Screen saver (display task only)
+    Screen screen = Screen::On;
+    int64_t lastActivityUs = 0;
+    int32_t dimSeconds = 0;
+    int32_t offSeconds = 0;
+    int32_t onPercent = 50;         // restored on wake
+    int32_t dimPercent = 20;
+    uint32_t screenConfigAge = 0;
+
+    // Sensor assignment popup, auto-assigned by popupTimer
     lv_obj_t *assignPopup = nullptr;
+    lv_timer_t *popupTimer = nullptr;
     uint64_t popupSensorAddress = 0;
-    TickType_t popupShownAt = 0;
 
     void Work();
+    void UpdateStats(int64_t handlerUs, int64_t busyUs, uint32_t wakeups,
+                     Display_WT32SC01::Counters &last, int64_t elapsedUs);
+#if !LV_TICK_CUSTOM
     static void LvglTickCb(void *arg);
+#endif
+    void LoadScreenConfig();
+    void UpdateScreen();
+    void WakeScreen();
     void NavigateTo(const char *page);
+    void EvictIdlePages();
+    void OnNavigateFrame();
 
     // Popup
+    void OfferPendingSensor();
     void ShowAssignPopup(uint64_t address);
     void CloseAssignPopup();
     void OnSlotSelected(int slot);
-    void AutoAssignToFirstEmpty();
+    void AssignToFirstEmpty(int firstSlot);
     static void PopupEventCb(lv_event_t *e);
+    static void PopupTimeoutCb(lv_timer_t *timer);
 };
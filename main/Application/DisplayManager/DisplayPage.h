@@ -5,6 +5,7 @@
 
 class ServiceProvider;
 class SettingsManager;
+struct SensorSnapshot;
 
 using NavigateFunc = std::function<void(const char *)>;
 
@@ -16,15 +17,35 @@ public:
 
     virtual ~DisplayPage() = default;
 
+    /// Builds the widgets on first use; afterwards only unhides them.
     void Show(lv_obj_t *parent)
     {
         if (panel)
+        {
+            lv_obj_clear_flag(panel, LV_OBJ_FLAG_HIDDEN);
+            OnShow();
             return;
+        }
         panel = CreatePanel(parent);
         OnCreate();
     }
 
+    /// Hides a persistent page, deletes any other.
     void Hide()
+    {
+        if (!panel)
+            return;
+        if (!IsPersistent())
+        {
+            Evict();
+            return;
+        }
+        HideKeyboard();
+        lv_obj_add_flag(panel, LV_OBJ_FLAG_HIDDEN);
+    }
+
+    /// Deletes the widgets; the next Show builds them again.
+    void Evict()
     {
         if (panel)
         {
@@ -34,9 +55,13 @@ public:
         }
     }
 
-    bool IsVisible() const { return panel != nullptr; }
+    bool IsVisible() const { return panel != nullptr && !lv_obj_has_flag(panel, LV_OBJ_FLAG_HIDDEN); }
+    bool IsCreated() const { return panel != nullptr; }
 
+    /// Called about once a second while the page is shown.
     virtual void Update() {}
+    /// Called after every sensor read cycle while the page is shown.
+    virtual void OnReadings(const SensorSnapshot &snapshot) {}
 
     void SetNavigator(NavigateFunc nav) { navigate = nav; }
 
@@ -46,6 +71,12 @@ protected:
     NavigateFunc navigate;
 
     virtual void OnCreate() = 0;
+    /// Called when a kept page is shown again; widgets still hold what they
+    /// showed when it was hidden.
+    virtual void OnShow() {}
+    /// Forms return false so every visit starts from the stored settings
+    /// instead of leftover unsaved edits.
+    virtual bool IsPersistent() const { return true; }
 
     // ── UI Helpers ───────────────────────────────────────────
 
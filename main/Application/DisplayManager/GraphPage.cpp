@@ -1,6 +1,7 @@
 #include "GraphPage.h"
 #include "SettingsManager/SettingsManager.h"
 #include "MonitorManager/MonitorManager.h"
+#include <cinttypes>
 #include <cstdio>
 #include <cstdlib>
 
@@ -10,13 +11,13 @@ void GraphPage::OnCreate()
 
     char buf[16];
 
-    snprintf(buf, sizeof(buf), "%ld", settingsManager.getInt("history.rate", 10));
+    int32_t rate = settingsManager.getInt("monitor.rate", MonitorManager::DEFAULT_RATE_SECONDS);
+    snprintf(buf, sizeof(buf), "%" PRId32, rate);
     AddTextRow("Sample (s)", buf, 50, 6);
 
     // Duration hint
-    int32_t rate = settingsManager.getInt("monitor.rate", MonitorManager::DEFAULT_RATE_SECONDS);
     char durationBuf[48];
-    snprintf(durationBuf, sizeof(durationBuf), "Rate: %lds (persistent flash log)", rate);
+    snprintf(durationBuf, sizeof(durationBuf), "Rate: %" PRId32 "s (persistent flash log)", rate);
 
     lv_obj_t *durationLabel = lv_label_create(panel);
     lv_label_set_text(durationLabel, durationBuf);
@@ -24,10 +25,10 @@ void GraphPage::OnCreate()
     lv_obj_set_style_text_font(durationLabel, &lv_font_montserrat_14, LV_PART_MAIN);
     lv_obj_set_pos(durationLabel, 130, 86);
 
-    snprintf(buf, sizeof(buf), "%ld", settingsManager.getInt("graph.min", 0));
+    snprintf(buf, sizeof(buf), "%" PRId32, settingsManager.getInt("graph.min", 0));
     AddTextRow("Y Min", buf, 110, 6);
 
-    snprintf(buf, sizeof(buf), "%ld", settingsManager.getInt("graph.max", 100));
+    snprintf(buf, sizeof(buf), "%" PRId32, settingsManager.getInt("graph.max", 100));
     AddTextRow("Y Max", buf, 150, 6);
 
     lv_obj_t *saveBtn = AddButton(LV_SYMBOL_OK " Save & Reboot",
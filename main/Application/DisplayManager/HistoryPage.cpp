@@ -0,0 +1,291 @@
+#include "HistoryPage.h"
+#include "ChannelColors.h"
+#include "DateTime.h"
+#include "esp_heap_caps.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+
+// Chart values are 0.1 °C
+static int32_t ToDeci(int16_t centi)
+{
+    return centi >= 0 ? (centi + 5) / 10 : (centi - 5) / 10;
+}
+
+void HistoryPage::OnCreate()
+{
+    AddTopBar(LV_SYMBOL_IMAGE " History");
+
+    if (!points)
+    {
+        // One bucket per column; PSRAM with internal RAM fallback
+        points = static_cast<TemperaturePoint *>(
+            heap_caps_calloc(COLUMNS, sizeof(TemperaturePoint), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+        if (!points)
+            points = static_cast<TemperaturePoint *>(calloc(COLUMNS, sizeof(TemperaturePoint)));
+    }
+
+    chart = lv_chart_create(panel);
+    lv_obj_set_size(chart, LCD_HRES - 12, LCD_VRES - 46 - 50);
+    lv_obj_set_pos(chart, 6, 46);
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_point_count(chart, COLUMNS * 2);
+    lv_obj_set_style_size(chart, 0, LV_PART_INDICATOR);
+    lv_chart_set_div_line_count(chart, 5, 8);
+    lv_obj_set_style_bg_color(chart, lv_color_hex(0x0c0c0c), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(chart, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_border_width(chart, 1, LV_PART_MAIN);
+    lv_obj_set_style_border_color(chart, lv_color_hex(0x333333), LV_PART_MAIN);
+    lv_obj_set_style_radius(chart, 6, LV_PART_MAIN);
+    lv_obj_set_style_pad_all(chart, 4, LV_PART_MAIN);
+    lv_obj_set_style_line_color(chart, lv_color_hex(0x222222), LV_PART_MAIN);
+    lv_obj_clear_flag(chart, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(chart, ChartEventCb, LV_EVENT_ALL, this);
+
+    for (int i = 0; i < 4; i++)
+        chartSeries[i] = lv_chart_add_series(chart, CHANNEL_COLORS[i], LV_CHART_AXIS_PRIMARY_Y);
+
+    // Zoom and "back to now"
+    lv_obj_t *zoomOut = AddButton(LV_SYMBOL_MINUS, lv_color_hex(0x303030), 50, 36, [](lv_event_t *e) {
+        static_cast<HistoryPage *>(lv_event_get_user_data(e))->Zoom(1);
+    });
+    lv_obj_set_pos(zoomOut, 8, LCD_VRES - 42);
+
+    lv_obj_t *zoomIn = AddButton(LV_SYMBOL_PLUS, lv_color_hex(0x303030), 50, 36, [](lv_event_t *e) {
+        static_cast<HistoryPage *>(lv_event_get_user_data(e))->Zoom(-1);
+    });
+    lv_obj_set_pos(zoomIn, 64, LCD_VRES - 42);
+
+    lv_obj_t *nowBtn = AddButton("Now", lv_color_hex(0x303030), 60, 36, [](lv_event_t *e) {
+        auto *self = static_cast<HistoryPage *>(lv_event_get_user_data(e));
+        self->SetView(self->span, 0);
+    });
+    lv_obj_set_pos(nowBtn, 120, LCD_VRES - 42);
+
+    rangeLabel = lv_label_create(panel);
+    lv_obj_set_style_text_color(rangeLabel, lv_color_white(), LV_PART_MAIN);
+    lv_obj_set_style_text_font(rangeLabel, &lv_font_montserrat_14, LV_PART_MAIN);
+    lv_obj_align(rangeLabel, LV_ALIGN_BOTTOM_RIGHT, -10, -24);
+
+    scaleLabel = lv_label_create(panel);
+    lv_obj_set_style_text_color(scaleLabel, lv_color_hex(0x888888), LV_PART_MAIN);
+    lv_obj_set_style_text_font(scaleLabel, &lv_font_montserrat_10, LV_PART_MAIN);
+    lv_obj_align(scaleLabel, LV_ALIGN_BOTTOM_RIGHT, -10, -6);
+
+    gesturePoints = 0;
+    Render();
+}
+
+void HistoryPage::OnShow()
+{
+    gesturePoints = 0;
+    Render();
+}
+
+void HistoryPage::Update()
+{
+    // Only the live view moves on its own, one column at a time
+    if (end != 0)
+        return;
+    uint32_t column = (span + COLUMNS - 1) / COLUMNS;
+    if (static_cast<uint32_t>(DateTime::Now().UtcSeconds()) / column != renderedColumn)
+        Render();
+}
+
+// ── Rendering ────────────────────────────────────────────────
+
+void HistoryPage::Render()
+{
+    if (!chart || !points)
+        return;
+
+    uint32_t now = static_cast<uint32_t>(DateTime::Now().UtcSeconds());
+    uint32_t viewEnd = end == 0 || end > now ? now : end;
+    uint32_t column = (span + COLUMNS - 1) / COLUMNS;  // seconds per pixel column
+    uint32_t to = (viewEnd / column + 1) * column;      // include the partial newest column
+    uint32_t from = to > column * COLUMNS ? to - column * COLUMNS : 0;
+    renderedColumn = viewEnd / column;
+
+    // One bucket per column. When no ring that fine reaches back to `from`,
+    // fall back to the coarser rings and stretch their buckets over columns.
+    size_t count = 0;
+    uint32_t resolution = column;
+    bool found = historyCache.Query(from, to, resolution, points, COLUMNS, count);
+    for (size_t t = 0; !found && t < HistoryCache::TIER_COUNT; t++)
+    {
+        if (HistoryCache::TIERS[t].periodSeconds <= column)
+            continue;
+        resolution = HistoryCache::TIERS[t].periodSeconds;
+        found = historyCache.Query(from, to, resolution, points, COLUMNS, count);
+    }
+    if (!found)
+        count = 0;
+
+    // Min and max of every column as two consecutive points, ordered so the
+    // line continues from the previous column instead of zig-zagging
+    int32_t lo = INT32_MAX, hi = INT32_MIN;
+    for (int i = 0; i < 4; i++)
+    {
+        lv_coord_t *y = lv_chart_get_y_array(chart, chartSeries[i]);
+        std::fill(y, y + COLUMNS * 2, LV_CHART_POINT_NONE);
+
+        int32_t previous = INT32_MIN;
+        for (size_t p = 0; p < count; p++)
+        {
+            const TemperaturePoint &point = points[p];
+            if (!point.IsValid(i) || point.timestamp < from)
+                continue;
+
+            int32_t min = ToDeci(point.min[i]);
+            int32_t max = ToDeci(point.max[i]);
+            lo = std::min(lo, min);
+            hi = std::max(hi, max);
+
+            uint32_t first = (point.timestamp - from) / column;
+            uint32_t last = std::min((point.timestamp + resolution - 1 - from) / column, COLUMNS - 1);
+            for (uint32_t c = first; c <= last; c++)
+            {
+                bool maxFirst = previous != INT32_MIN && std::abs(previous - max) < std::abs(previous - min);
+                y[c * 2] = (lv_coord_t)(maxFirst ? max : min);
+                y[c * 2 + 1] = (lv_coord_t)(maxFirst ? min : max);
+                previous = y[c * 2 + 1];
+            }
+        }
+    }
+
+    char buf[48];
+    if (lo > hi)
+    {
+        lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, 0, 1000);
+        lv_label_set_text(scaleLabel, "No history for this range");
+    }
+    else
+    {
+        // Whole degrees with a degree of headroom
+        int32_t low = (int32_t)std::floor(lo / 10.0f) * 10 - 10;
+        int32_t high = (int32_t)std::ceil(hi / 10.0f) * 10 + 10;
+        lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, low, high);
+        snprintf(buf, sizeof(buf), "%ld - %ld °C", (long)(low / 10), (long)(high / 10));
+        lv_label_set_text(scaleLabel, buf);
+    }
+
+    char startBuf[20], endBuf[20];
+    DateTime::FromUtc(viewEnd - std::min(span, viewEnd)).ToStringLocal(startBuf, sizeof(startBuf), "%a %H:%M");
+    DateTime::FromUtc(viewEnd).ToStringLocal(endBuf, sizeof(endBuf), end == 0 ? "now" : "%a %H:%M");
+    snprintf(buf, sizeof(buf), "%s - %s", startBuf, endBuf);
+    lv_label_set_text(rangeLabel, buf);
+
+    lv_chart_refresh(chart);
+}
+
+// ── View ─────────────────────────────────────────────────────
+
+void HistoryPage::SetView(uint32_t newSpan, uint32_t newEnd)
+{
+    uint32_t now = static_cast<uint32_t>(DateTime::Now().UtcSeconds());
+    newSpan = std::clamp(newSpan, MIN_SPAN, MAX_SPAN);
+
+    // Stay within the week the cache holds; reaching the present follows it
+    uint32_t oldest = now > MAX_SPAN ? now - MAX_SPAN : 0;
+    if (newEnd != 0 && newEnd < oldest + newSpan)
+        newEnd = oldest + newSpan;
+    if (newEnd >= now)
+        newEnd = 0;
+
+    // Redraw only when the view moved by at least a column
+    uint32_t column = (newSpan + COLUMNS - 1) / COLUMNS;
+    bool moved = newSpan != span || (newEnd == 0) != (end == 0) || newEnd / column != end / column;
+    span = newSpan;
+    end = newEnd;
+    if (moved)
+        Render();
+}
+
+void HistoryPage::Zoom(int direction)
+{
+    // Next preset step, keeping the centre of the view in place
+    uint32_t newSpan = span;
+    if (direction < 0)
+    {
+        for (size_t i = std::size(ZOOM_STEPS); i-- > 0;)
+            if (ZOOM_STEPS[i] < span) { newSpan = ZOOM_STEPS[i]; break; }
+    }
+    else
+    {
+        for (uint32_t step : ZOOM_STEPS)
+            if (step > span) { newSpan = step; break; }
+    }
+
+    if (end == 0)
+    {
+        SetView(newSpan, 0);
+        return;
+    }
+    uint32_t centre = end - span / 2;
+    SetView(newSpan, centre + newSpan / 2);
+}
+
+void HistoryPage::OnPressing()
+{
+    lv_point_t touch[Display_WT32SC01::MAX_TOUCH_POINTS];
+    uint8_t n = display.GetTouchPoints(touch);
+    if (n == 0)
+        return;
+
+    // A finger added or lifted starts a new gesture from the current view
+    uint32_t now = static_cast<uint32_t>(DateTime::Now().UtcSeconds());
+    if (n != gesturePoints)
+    {
+        gesturePoints = n;
+        dragStart = touch[0];
+        dragEnd = end == 0 ? now : end;
+        pinchSpan = span;
+        pinchDistance = n >= 2 ? (int32_t)std::hypot(touch[1].x - touch[0].x, touch[1].y - touch[0].y) : 0;
+        return;
+    }
+
+    if (n >= 2)
+    {
+        // Pinch: span scales with the finger distance, centre stays put
+        int32_t distance = (int32_t)std::hypot(touch[1].x - touch[0].x, touch[1].y - touch[0].y);
+        if (pinchDistance < 20 || distance < 1)
+            return;
+        uint32_t newSpan = std::clamp<uint32_t>(
+            (uint32_t)((uint64_t)pinchSpan * pinchDistance / distance), MIN_SPAN, MAX_SPAN);
+        uint32_t centre = dragEnd - pinchSpan / 2;
+        SetView(newSpan, centre + newSpan / 2);
+        return;
+    }
+
+    // Drag: the content follows the finger
+    lv_coord_t width = lv_obj_get_content_width(chart);
+    if (width <= 0)
+        return;
+    int64_t shift = (int64_t)(touch[0].x - dragStart.x) * span / width;
+    int64_t newEnd = (int64_t)dragEnd - shift;
+    SetView(span, newEnd > 0 ? (uint32_t)newEnd : 1);
+}
+
+void HistoryPage::ChartEventCb(lv_event_t *e)
+{
+    auto *self = static_cast<HistoryPage *>(lv_event_get_user_data(e));
+    switch (lv_event_get_code(e))
+    {
+    case LV_EVENT_PRESSED:
+        self->gesturePoints = 0;
+        self->OnPressing();
+        break;
+    case LV_EVENT_PRESSING:
+        self->OnPressing();
+        break;
+    case LV_EVENT_RELEASED:
+    case LV_EVENT_PRESS_LOST:
+        self->gesturePoints = 0;
+        break;
+    default:
+        break;
+    }
+}
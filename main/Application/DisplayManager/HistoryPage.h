@@ -0,0 +1,56 @@
+#pragma once
+#include "DisplayPage.h"
+#include "HistoryCache/HistoryCache.h"
+#include "Display_WT32SC01.h"
+
+/// Touch history browser: drag to pan, pinch (or the +/- buttons) to zoom
+/// between 15 minutes and a week.
+///
+/// Every render asks HistoryCache for one min/max bucket per pixel column;
+/// the cache answers from the coarsest of its rings (1 s / 10 s / 1 min)
+/// that is fine enough, so a frame costs at most COLUMNS * 2 points per
+/// series whatever the span, and panning never touches flash.
+class HistoryPage : public DisplayPage
+{
+public:
+    HistoryPage(HistoryCache &history, Display_WT32SC01 &display)
+        : historyCache(history), display(display) {}
+
+    void Update() override;
+
+private:
+    static constexpr uint32_t COLUMNS = 240;            // two chart points (min, max) each
+    static constexpr uint32_t MIN_SPAN = 15 * 60;
+    static constexpr uint32_t MAX_SPAN = 7 * 86400;
+    static constexpr uint32_t ZOOM_STEPS[] = {15 * 60, 3600, 6 * 3600, 86400, 7 * 86400};
+
+    HistoryCache &historyCache;
+    Display_WT32SC01 &display;
+
+    lv_obj_t *chart = nullptr;
+    lv_obj_t *rangeLabel = nullptr;
+    lv_obj_t *scaleLabel = nullptr;
+    lv_chart_series_t *chartSeries[4] = {};
+    TemperaturePoint *points = nullptr;                 // COLUMNS, allocated on first show
+
+    // View: `end` = 0 follows the current time
+    uint32_t span = 3600;
+    uint32_t end = 0;
+    uint32_t renderedColumn = 0;                        // newest column drawn while following
+
+    // Gesture state, relative to where the current finger count started
+    lv_point_t dragStart = {};
+    uint32_t dragEnd = 0;
+    uint32_t pinchSpan = 0;
+    int32_t pinchDistance = 0;
+    uint8_t gesturePoints = 0;
+
+    void OnCreate() override;
+    void OnShow() override;
+    void Render();
+    void SetView(uint32_t newSpan, uint32_t newEnd);
+    void Zoom(int direction);
+    void OnPressing();
+
+    static void ChartEventCb(lv_event_t *e);
+};
@@ -1,13 +1,14 @@
 #include "HomePage.h"
+#include "ChannelColors.h"
 #include "DateTime.h"
+#include "esp_heap_caps.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
 #include <cstdio>
-
-static const lv_color_t channelColors[4] = {
-    lv_palette_main(LV_PALETTE_RED),
-    lv_palette_main(LV_PALETTE_BLUE),
-    lv_palette_main(LV_PALETTE_GREEN),
-    lv_palette_main(LV_PALETTE_YELLOW)
-};
+#include <cstdlib>
+#include <memory>
+#include <new>
 
 void HomePage::OnCreate()
 {
@@ -38,19 +39,27 @@ void HomePage::OnCreate()
         lv_obj_set_style_bg_color(box, lv_color_hex(0x1a1a1a), LV_PART_MAIN);
         lv_obj_set_style_bg_opa(box, LV_OPA_COVER, LV_PART_MAIN);
         lv_obj_set_style_border_width(box, 2, LV_PART_MAIN);
-        lv_obj_set_style_border_color(box, channelColors[i], LV_PART_MAIN);
+        lv_obj_set_style_border_color(box, CHANNEL_COLORS[i], LV_PART_MAIN);
         lv_obj_set_style_radius(box, 6, LV_PART_MAIN);
         lv_obj_set_style_pad_all(box, 0, LV_PART_MAIN);
         lv_obj_clear_flag(box, LV_OBJ_FLAG_SCROLLABLE);
 
         lv_obj_t *label = lv_label_create(box);
         lv_label_set_text(label, "--.--");
-        lv_obj_align(label, LV_ALIGN_CENTER, 0, 0);
-        lv_obj_set_style_text_color(label, channelColors[i], LV_PART_MAIN);
+        lv_obj_align(label, LV_ALIGN_CENTER, 0, -7);
+        lv_obj_set_style_text_color(label, CHANNEL_COLORS[i], LV_PART_MAIN);
         lv_obj_set_style_text_font(label, &lv_font_montserrat_20, LV_PART_MAIN);
 
+        // 24 h min / max under the reading
+        lv_obj_t *range = lv_label_create(box);
+        lv_label_set_text(range, "");
+        lv_obj_align(range, LV_ALIGN_BOTTOM_MID, 0, -3);
+        lv_obj_set_style_text_color(range, lv_color_hex(0x888888), LV_PART_MAIN);
+        lv_obj_set_style_text_font(range, &lv_font_montserrat_10, LV_PART_MAIN);
+
         tempBoxes[i] = box;
         tempLabels[i] = label;
+        rangeLabels[i] = range;
     }
 
     // Chart
@@ -64,7 +73,7 @@ void HomePage::OnCreate()
     lv_obj_set_pos(chart, slotMargin, chartY);
     lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
     lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_SHIFT);
-    lv_chart_set_point_count(chart, 120);
+    lv_chart_set_point_count(chart, CHART_POINTS);
     lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, graphMin, graphMax);
     lv_obj_set_style_size(chart, 0, LV_PART_INDICATOR);
     lv_chart_set_div_line_count(chart, 5, 10);
@@ -77,7 +86,12 @@ void HomePage::OnCreate()
     lv_obj_set_style_pad_right(chart, 4, LV_PART_MAIN);
     lv_obj_set_style_pad_top(chart, 4, LV_PART_MAIN);
     lv_obj_set_style_pad_bottom(chart, 4, LV_PART_MAIN);
-    lv_obj_clear_flag(chart, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_clear_flag(chart, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(chart, [](lv_event_t *e) {
+        auto *page = static_cast<HomePage *>(lv_event_get_user_data(e));
+        if (page->navigate)
+            page->navigate("history");
+    }, LV_EVENT_CLICKED, this);
     lv_obj_set_style_line_color(chart, lv_color_hex(0x222222), LV_PART_MAIN);
 
     // Y-axis labels
@@ -85,16 +99,28 @@ void HomePage::OnCreate()
     int32_t step = (graphMax - graphMin) / 5;
     for (int i = 0; i <= 5; i++)
     {
-        snprintf(buf, sizeof(buf), "%ld", graphMax - i * step);
+        snprintf(buf, sizeof(buf), "%" PRId32, graphMax - i * step);
         lv_obj_t *lbl = lv_label_create(chart);
         lv_label_set_text(lbl, buf);
         lv_obj_set_style_text_color(lbl, lv_color_hex(0x666666), LV_PART_MAIN);
         lv_obj_set_style_text_font(lbl, &lv_font_montserrat_10, LV_PART_MAIN);
         lv_obj_set_pos(lbl, 2, (lv_coord_t)(i * (chartH - 8) / 5));
     }
+    CacheChartBackground();
 
     for (int i = 0; i < 4; i++)
-        chartSeries[i] = lv_chart_add_series(chart, channelColors[i], LV_CHART_AXIS_PRIMARY_Y);
+        chartSeries[i] = lv_chart_add_series(chart, CHANNEL_COLORS[i], LV_CHART_AXIS_PRIMARY_Y);
+    lastChartUs = 0;
+    chartBackfilled = BackfillChart();
+
+    // Fresh widgets: everything is drawn once
+    shownClock = -1;
+    shownNetworkGeneration = UINT32_MAX;
+    for (int i = 0; i < 4; i++)
+    {
+        shownTemp[i] = NOT_SHOWN;
+        shownRange[i][0] = shownRange[i][1] = NOT_SHOWN;
+    }
 
     // Gear button (on top)
     lv_obj_t *gearBtn = lv_btn_create(panel);
@@ -118,39 +144,187 @@ void HomePage::OnCreate()
     }, LV_EVENT_CLICKED, this);
 }
 
+void HomePage::CacheChartBackground()
+{
+#if LV_USE_SNAPSHOT
+    // Only the series change. Render the rest into an image once, so a chart
+    // update blits it instead of redrawing the rounded frame, the grid and
+    // six labels
+    lv_obj_update_layout(chart);
+    uint32_t size = lv_snapshot_buf_size_needed(chart, LV_IMG_CF_TRUE_COLOR);
+    if (size > chartBackgroundSize)
+    {
+        heap_caps_free(chartBackgroundBuf);
+        chartBackgroundBuf = static_cast<uint8_t *>(heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+        chartBackgroundSize = chartBackgroundBuf ? size : 0;
+    }
+    if (!chartBackgroundBuf || lv_snapshot_take_to_buf(chart, LV_IMG_CF_TRUE_COLOR, &chartBackground,
+                                                       chartBackgroundBuf, chartBackgroundSize) != LV_RES_OK)
+    {
+        ESP_LOGW("HomePage", "No chart background cache, drawing the chart in full");
+        return;
+    }
+
+    // Opaque and covering the chart, so LVGL starts redraws from the image.
+    // The snapshot includes the chart's extra draw area around it.
+    lv_coord_t ext = (chartBackground.header.w - lv_obj_get_width(chart)) / 2;
+    lv_obj_t *background = lv_img_create(panel);
+    lv_img_set_src(background, &chartBackground);
+    lv_obj_set_pos(background, lv_obj_get_x(chart) - ext, lv_obj_get_y(chart) - ext);
+    lv_obj_move_to_index(background, lv_obj_get_index(chart));
+
+    // Border and padding still size the plot area; just stop drawing them
+    lv_obj_clean(chart);
+    lv_chart_set_div_line_count(chart, 0, 0);
+    lv_obj_set_style_bg_opa(chart, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_set_style_border_opa(chart, LV_OPA_TRANSP, LV_PART_MAIN);
+#endif
+}
+
+void HomePage::OnShow()
+{
+    // No readings arrive while hidden; redraw the missed minutes and
+    // continue with the next reading
+    lastChartUs = 0;
+    chartBackfilled = BackfillChart();
+}
+
 void HomePage::Update()
 {
     char buf[32];
 
     DateTime now = DateTime::Now();
-    now.ToStringLocal(buf, sizeof(buf), "%H:%M:%S");
-    lv_label_set_text(labelTime, buf);
+    int64_t clock = now.UtcSeconds();
+    if (clock != shownClock)
+    {
+        shownClock = clock;
+        now.ToStringLocal(buf, sizeof(buf), "%H:%M:%S");
+        lv_label_set_text(labelTime, buf);
+    }
+
+    // The address only changes on a network event
+    uint32_t generation = networkManager.GetStatusGeneration();
+    if (generation != shownNetworkGeneration)
+    {
+        shownNetworkGeneration = generation;
+        auto status = networkManager.wifi().getStatus();
+        if (status.has_ipv4)
+            snprintf(buf, sizeof(buf), IPSTR, IP2STR(&status.ipv4.ip));
+        else
+            snprintf(buf, sizeof(buf), "No IP");
+        lv_label_set_text(labelIP, buf);
+    }
+}
 
-    auto status = networkManager.wifi().getStatus();
-    if (status.has_ipv4)
-        snprintf(buf, sizeof(buf), IPSTR, IP2STR(&status.ipv4.ip));
-    else
-        snprintf(buf, sizeof(buf), "No IP");
-    lv_label_set_text(labelIP, buf);
+void HomePage::OnReadings(const SensorSnapshot &snap)
+{
+    char buf[16];
 
-    chartCounter++;
-    if (chartCounter > 60)
-        chartCounter = 0;
+    // One chart point a minute, from the first reading of each minute
+    bool chartDue = lastChartUs == 0 || snap.timestampUs - lastChartUs >= CHART_INTERVAL_US;
+    if (chartDue)
+    {
+        lastChartUs = snap.timestampUs;
+        // Clock or history was not ready when the page was created
+        if (!chartBackfilled)
+            chartBackfilled = BackfillChart();
+    }
 
     for (int i = 0; i < 4; i++)
     {
-        if (sensorManager.IsSlotActive(i))
+        bool active = snap.IsActive(i);
+        float temp = snap.temperatureC[i];
+
+        // Labels show 0.1 °C, so only a change at that resolution is redrawn
+        int32_t deci = active ? static_cast<int32_t>(lroundf(temp * 10.0f)) : NO_READING;
+        if (deci != shownTemp[i])
         {
-            float temp = sensorManager.GetTemperature(i);
-            snprintf(buf, sizeof(buf), "%.1f°", temp);
-            lv_label_set_text(tempLabels[i], buf);
-            if (chartCounter == 0)
-                lv_chart_set_next_value(chart, chartSeries[i], (lv_coord_t)temp);
+            shownTemp[i] = deci;
+            if (active)
+            {
+                snprintf(buf, sizeof(buf), "%.1f°", deci / 10.0f);
+                lv_label_set_text(tempLabels[i], buf);
+            }
+            else
+            {
+                lv_label_set_text(tempLabels[i], "--.--");
+            }
         }
+
+        // Appending invalidates the chart; nothing else does. Gaps keep the
+        // series aligned.
+        if (chartDue)
+            lv_chart_set_next_value(chart, chartSeries[i], active ? (lv_coord_t)temp : LV_CHART_POINT_NONE);
+    }
+    if (chartDue)
+        UpdateRanges();
+}
+
+void HomePage::UpdateRanges()
+{
+    char buf[32];
+    for (int i = 0; i < 4; i++)
+    {
+        RollingStats::Stats stats;
+        bool valid = rollingStats.Get(i, RANGE_WINDOW, stats);
+        int32_t min = valid ? static_cast<int32_t>(lroundf(stats.min * 10.0f)) : NO_READING;
+        int32_t max = valid ? static_cast<int32_t>(lroundf(stats.max * 10.0f)) : NO_READING;
+        if (min == shownRange[i][0] && max == shownRange[i][1])
+            continue;
+
+        shownRange[i][0] = min;
+        shownRange[i][1] = max;
+        if (valid)
+            snprintf(buf, sizeof(buf), "%s %.1f / %.1f", RollingStats::WINDOWS[RANGE_WINDOW].name, min / 10.0f, max / 10.0f);
         else
+            buf[0] = '\0';
+        lv_label_set_text(rangeLabels[i], buf);
+    }
+}
+
+bool HomePage::BackfillChart()
+{
+    // The minutes before the current one, so the next live point continues
+    // the line. Answered from the in-RAM history, which is pre-warmed from
+    // flash at boot.
+    uint32_t now = static_cast<uint32_t>(DateTime::Now().UtcSeconds());
+    uint32_t interval = static_cast<uint32_t>(CHART_INTERVAL_US / 1000000);
+    uint32_t to = now / interval * interval;
+    if (to < CHART_POINTS * interval)
+        return false;
+    uint32_t from = to - CHART_POINTS * interval;
+
+    std::unique_ptr<TemperaturePoint[]> points(new (std::nothrow) TemperaturePoint[CHART_POINTS]);
+    size_t count = 0;
+    if (!points || !historyCache.Query(from, to, interval, points.get(), CHART_POINTS, count))
+        return false;
+
+    // Fill the series arrays directly (oldest first from index 0, where
+    // SHIFT mode starts after the reset) and invalidate the chart once.
+    // Minutes without data stay gaps.
+    for (int i = 0; i < 4; i++)
+    {
+        lv_coord_t *y = lv_chart_get_y_array(chart, chartSeries[i]);
+        std::fill(y, y + CHART_POINTS, LV_CHART_POINT_NONE);
+        lv_chart_set_x_start_point(chart, chartSeries[i], 0);
+        int32_t previous = NO_READING;
+        for (size_t p = 0; p < count; p++)
         {
-            lv_label_set_text(tempLabels[i], "--.--");
+            const TemperaturePoint &point = points[p];
+            uint32_t index = (point.timestamp - from) / interval;
+            if (index >= CHART_POINTS || !point.IsValid(i))
+                continue;
+
+            // Min/max decimation: plot whichever extreme of the minute is
+            // further from the previous point, so short spikes survive
+            int32_t centi = point.avg[i];
+            if (previous != NO_READING)
+                centi = std::abs(point.max[i] - previous) > std::abs(point.min[i] - previous)
+                      ? point.max[i] : point.min[i];
+            previous = centi;
+            y[index] = (lv_coord_t)TemperaturePoint::FromCenti(static_cast<int16_t>(centi));
         }
     }
     lv_chart_refresh(chart);
+    return true;
 }
@@ -3,27 +3,60 @@
 #include "SensorManager/SensorManager.h"
 #include "NetworkManager/NetworkManager.h"
 #include "SettingsManager/SettingsManager.h"
+#include "RollingStats/RollingStats.h"
+#include "HistoryCache/HistoryCache.h"
+#include <climits>
 
 class HomePage : public DisplayPage
 {
 public:
-    HomePage(NetworkManager &net, SensorManager &sensor, SettingsManager &settings)
-        : networkManager(net), sensorManager(sensor), settingsManager(settings) {}
+    HomePage(NetworkManager &net, SensorManager &sensor, SettingsManager &settings, RollingStats &stats,
+             HistoryCache &history)
+        : networkManager(net), sensorManager(sensor), settingsManager(settings), rollingStats(stats),
+          historyCache(history) {}
 
     void Update() override;
+    void OnReadings(const SensorSnapshot &snapshot) override;
 
 private:
     NetworkManager &networkManager;
     SensorManager &sensorManager;
     SettingsManager &settingsManager;
+    RollingStats &rollingStats;
+    HistoryCache &historyCache;
 
     lv_obj_t *labelTime = nullptr;
     lv_obj_t *labelIP = nullptr;
     lv_obj_t *tempBoxes[4] = {};
     lv_obj_t *tempLabels[4] = {};
+    lv_obj_t *rangeLabels[4] = {};
     lv_obj_t *chart = nullptr;
     lv_chart_series_t *chartSeries[4] = {};
-    int chartCounter = 0;
+    // Grid, axis labels and frame of the chart, rendered once (PSRAM); kept
+    // across evictions and reused when the page is built again
+    lv_img_dsc_t chartBackground = {};
+    uint8_t *chartBackgroundBuf = nullptr;
+    uint32_t chartBackgroundSize = 0;
+    int64_t lastChartUs = 0;
+    bool chartBackfilled = false;
+
+    // What the widgets currently show, so unchanged values are not redrawn.
+    // Temperatures in 0.1 °C; reset by OnCreate.
+    static constexpr int32_t NOT_SHOWN = INT32_MIN;
+    static constexpr int32_t NO_READING = INT32_MIN + 1;
+    int64_t shownClock = -1;
+    uint32_t shownNetworkGeneration = UINT32_MAX;
+    int32_t shownTemp[4] = {};
+    int32_t shownRange[4][2] = {};
+
+    static constexpr int64_t CHART_INTERVAL_US = 60 * 1000000LL;
+    static constexpr uint32_t CHART_POINTS = 120;
+
+    static constexpr size_t RANGE_WINDOW = 1;   // RollingStats::WINDOWS index shown on the tiles (24h)
 
     void OnCreate() override;
+    void OnShow() override;
+    void UpdateRanges();
+    void CacheChartBackground();
+    bool BackfillChart();
 };
@@ -1,6 +1,7 @@
 #include "SensorPage.h"
 #include "SettingsManager/SettingsManager.h"
 #include "SensorManager/SensorManager.h"
+#include <cinttypes>
 #include <cstdio>
 #include <cstdlib>
 
@@ -10,10 +11,10 @@ void SensorPage::OnCreate()
 
     char buf[16];
 
-    snprintf(buf, sizeof(buf), "%ld", settingsManager.getInt("sensor.scan", 5000));
-    AddTextRow("Scan (ms)", buf, 50, 8);
+    snprintf(buf, sizeof(buf), "%" PRId32, settingsManager.getInt("sensor.scan", 5000));
+    AddTextRow("Check (ms)", buf, 50, 8);
 
-    snprintf(buf, sizeof(buf), "%ld", settingsManager.getInt("sensor.read", 1000));
+    snprintf(buf, sizeof(buf), "%" PRId32, settingsManager.getInt("sensor.read", 1000));
     AddTextRow("Read (ms)", buf, 90, 8);
 
     lv_obj_t *clearBtn = AddButton(LV_SYMBOL_TRASH " Clear All Assignments",
@@ -15,6 +15,7 @@ private:
     SensorManager &sensorManager;
 
     void OnCreate() override;
+    bool IsPersistent() const override { return false; }
 
     static void ClearCb(lv_event_t *e);
     static void SaveCb(lv_event_t *e);
@@ -12,6 +12,7 @@ private:
     SettingsManager &settingsManager;
 
     void OnCreate() override;
+    bool IsPersistent() const override { return false; }
 
     static void SaveCb(lv_event_t *e);
 };
@@ -18,6 +18,7 @@ private:
     lv_obj_t *passwordTa = nullptr;
 
     void OnCreate() override;
+    bool IsPersistent() const override { return false; }
     void RunScan();
     void SelectNetwork(const char *ssid);
 
@@ -0,0 +1,231 @@
+#include "HistoryCache.h"
+#include "LogManager.h"
+#include "MonitorManager.h"
+#include "SettingsManager.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include <cstring>
+
+HistoryCache::HistoryCache(ServiceProvider& serviceProvider)
+    : serviceProvider_(serviceProvider)
+    , logManager_(serviceProvider.getLogManager())
+{
+}
+
+void HistoryCache::Init()
+{
+    auto initAttempt = initState_.TryBeginInit();
+    if (!initAttempt)
+    {
+        return;
+    }
+
+    size_t totalBytes = 0;
+    for (size_t i = 0; i < TIER_COUNT; i++)
+    {
+        // Rings live in PSRAM; they do not fit in internal RAM, so without
+        // PSRAM the cache stays not-ready and queries fall back to flash
+        auto* cells = static_cast<Cell*>(
+            heap_caps_calloc(TIERS[i].capacity, sizeof(Cell), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+        if (!cells)
+        {
+            ESP_LOGE(TAG, "No PSRAM for the %u s ring, history cache disabled", (unsigned)TIERS[i].periodSeconds);
+            for (size_t j = 0; j < i; j++)
+            {
+                heap_caps_free(rings_[j].cells);
+                rings_[j].cells = nullptr;
+            }
+            return;
+        }
+
+        rings_[i].cells = cells;
+        totalBytes += TIERS[i].capacity * sizeof(Cell);
+    }
+
+    PreWarm();
+
+    initAttempt.SetReady();
+    ESP_LOGI(TAG, "Initialized (%u tiers, %u KB)", (unsigned)TIER_COUNT, (unsigned)(totalBytes / 1024));
+}
+
+// ── Ingest ───────────────────────────────────────────────────
+
+void HistoryCache::AddSample(const TemperaturePoint& sample)
+{
+    if (sample.timestamp == 0 || sample.count == 0)
+        return;
+
+    LOCK(mutex_);
+    for (size_t i = 0; i < TIER_COUNT; i++)
+        Insert(i, sample);
+}
+
+void HistoryCache::Insert(size_t tier, const TemperaturePoint& sample)
+{
+    const auto& cfg = TIERS[tier];
+    Ring& ring = rings_[tier];
+    if (!ring.cells) return;
+
+    uint32_t bucket = sample.timestamp / cfg.periodSeconds;
+
+    if (ring.empty)
+    {
+        ring.newest = bucket;
+        ring.empty = false;
+    }
+    else if (bucket > ring.newest)
+    {
+        // Advance the head, clearing buckets that were skipped
+        uint32_t gap = bucket - ring.newest;
+        if (gap >= cfg.capacity)
+            memset(ring.cells, 0, cfg.capacity * sizeof(Cell));
+        else
+            for (uint32_t b = ring.newest + 1; b <= bucket; b++)
+                ring.cells[b % cfg.capacity] = Cell{};
+        ring.newest = bucket;
+    }
+    else if (ring.newest - bucket >= cfg.capacity)
+    {
+        return; // older than the ring reaches back
+    }
+
+    Cell& cell = ring.cells[bucket % cfg.capacity];
+    TemperaturePoint point = ToPoint(cell, bucket * cfg.periodSeconds);
+    point.Merge(sample);
+    FromPoint(point, cell);
+}
+
+void HistoryCache::PreWarm()
+{
+    uint32_t oldestRaw = UINT32_MAX;
+    size_t rawCount = 0;
+    size_t rollupCount = 0;
+
+    // Raw samples feed every ring. The log is change-driven, so unchanged
+    // slots and skipped samples are rebuilt on the monitor rate grid.
+    {
+        auto& settings = serviceProvider_.getSettingsManager();
+        uint32_t rate = settings.getInt("monitor.rate", MonitorManager::DEFAULT_RATE_SECONDS);
+        uint32_t heartbeat = settings.getInt("log.heartbeat", MonitorManager::DEFAULT_HEARTBEAT_SECONDS);
+
+        LogManager::ForEachReconstructed(logManager_.Read(), rate, heartbeat + rate,
+            [&](const TemperaturePoint& point) {
+                if (point.timestamp < oldestRaw)
+                    oldestRaw = point.timestamp;
+                for (size_t i = 0; i < TIER_COUNT; i++)
+                    Insert(i, point);
+                rawCount++;
+                return true;
+            });
+    }
+
+    // Minute rollups extend the coarse rings past what the raw log still holds
+    {
+        auto tier = LogManager::RollupTier::Minute;
+        uint32_t period = logManager_.RollupPeriod(tier);
+        auto view = logManager_.ReadRollup(tier);
+        for (auto entry : view)
+        {
+            TemperaturePoint point;
+            if (!LogManager::DecodeTemperaturePoint(entry, point) || point.timestamp == 0)
+                continue;
+            if (point.timestamp + period > oldestRaw)
+                continue;
+
+            for (size_t i = 0; i < TIER_COUNT; i++)
+            {
+                if (TIERS[i].periodSeconds >= period)
+                    Insert(i, point);
+            }
+            rollupCount++;
+        }
+    }
+
+    ESP_LOGI(TAG, "Pre-warmed from flash: %u samples, %u rollups",
+             (unsigned)rawCount, (unsigned)rollupCount);
+}
+
+// ── Query ────────────────────────────────────────────────────
+
+bool HistoryCache::Query(uint32_t from, uint32_t to, uint32_t resolution,
+                         TemperaturePoint* out, size_t maxPoints, size_t& count) const
+{
+    count = 0;
+    if (!initState_.IsReady() || to <= from)
+        return false;
+    if (resolution == 0)
+        resolution = 1;
+
+    LOCK(mutex_);
+
+    // Coarsest ring that is fine enough and still reaches back to `from`
+    int chosen = -1;
+    for (size_t i = TIER_COUNT; i-- > 0;)
+    {
+        if (i > 0 && TIERS[i].periodSeconds > resolution)
+            continue;
+        if (rings_[i].empty)
+            continue;
+
+        uint32_t oldestBucket = rings_[i].newest >= TIERS[i].capacity - 1
+                              ? rings_[i].newest - (TIERS[i].capacity - 1) : 0;
+        if (from >= oldestBucket * TIERS[i].periodSeconds)
+        {
+            chosen = static_cast<int>(i);
+            break;
+        }
+    }
+    if (chosen < 0)
+        return false;
+
+    const auto& cfg = TIERS[chosen];
+    const Ring& ring = rings_[chosen];
+
+    uint32_t first = from / cfg.periodSeconds;
+    uint32_t last = (to - 1) / cfg.periodSeconds;
+    if (last > ring.newest) last = ring.newest;
+
+    for (uint32_t b = first; b <= last; b++)
+    {
+        const Cell& cell = ring.cells[b % cfg.capacity];
+        uint32_t ts = b * cfg.periodSeconds;
+        if (cell.count == 0 || ts < from)
+            continue;
+
+        uint32_t bucketStart = from + ((ts - from) / resolution) * resolution;
+        TemperaturePoint point = ToPoint(cell, bucketStart);
+
+        if (count > 0 && out[count - 1].timestamp == bucketStart)
+        {
+            out[count - 1].Merge(point);
+            continue;
+        }
+        if (count >= maxPoints)
+            break;
+        out[count++] = point;
+    }
+    return true;
+}
+
+// ── Cell conversion ──────────────────────────────────────────
+
+TemperaturePoint HistoryCache::ToPoint(const Cell& cell, uint32_t timestamp)
+{
+    TemperaturePoint point;
+    point.timestamp = timestamp;
+    point.count = cell.count;
+    point.validMask = cell.validMask;
+    memcpy(point.avg, cell.avg, sizeof(point.avg));
+    memcpy(point.min, cell.min, sizeof(point.min));
+    memcpy(point.max, cell.max, sizeof(point.max));
+    return point;
+}
+
+void HistoryCache::FromPoint(const TemperaturePoint& point, Cell& cell)
+{
+    cell.count = point.count > UINT16_MAX ? UINT16_MAX : static_cast<uint16_t>(point.count);
+    cell.validMask = point.validMask;
+    memcpy(cell.avg, point.avg, sizeof(cell.avg));
+    memcpy(cell.min, point.min, sizeof(cell.min));
+    memcpy(cell.max, point.max, sizeof(cell.max));
+}
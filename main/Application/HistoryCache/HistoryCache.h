@@ -0,0 +1,79 @@
+#pragma once
+
+#include "ServiceProvider.h"
+#include "InitState.h"
+#include "Mutex.h"
+#include "RollupLog.h"
+#include <cstdint>
+
+class LogManager;
+
+/// In-RAM temperature history at several resolutions, kept in PSRAM.
+///
+/// Every sample is folded into each ring. A ring is a fixed array of buckets
+/// indexed by (timestamp / period) % capacity, so inserts and lookups are O(1)
+/// and out-of-order samples within the ring span are accepted. The rings are
+/// pre-warmed from the flash log at boot; afterwards chart and API queries are
+/// answered from RAM without touching flash or the log mutex.
+class HistoryCache
+{
+    static constexpr const char* TAG = "HistoryCache";
+
+public:
+    struct TierConfig { uint32_t periodSeconds; uint32_t capacity; };
+
+    // 1 s × 1 h, 10 s × 24 h, 1 min × 7 d
+    static constexpr TierConfig TIERS[] = {
+        {    1,  3600 },
+        {   10,  8640 },
+        {   60, 10080 },
+    };
+    static constexpr size_t TIER_COUNT = sizeof(TIERS) / sizeof(TIERS[0]);
+
+    explicit HistoryCache(ServiceProvider& serviceProvider);
+
+    HistoryCache(const HistoryCache&) = delete;
+    HistoryCache& operator=(const HistoryCache&) = delete;
+
+    void Init();
+
+    /// Fold a sample into every ring. Thread-safe.
+    void AddSample(const TemperaturePoint& sample);
+
+    /// Aggregate [from, to) into buckets of `resolution` seconds, oldest first.
+    /// Uses the coarsest ring that is fine enough and still reaches back to
+    /// `from`. Returns false (and writes nothing) if no ring covers the range,
+    /// in which case the caller should fall back to flash.
+    bool Query(uint32_t from, uint32_t to, uint32_t resolution,
+               TemperaturePoint* out, size_t maxPoints, size_t& count) const;
+
+private:
+    // Compact bucket — the start time is implied by the ring position
+    struct Cell
+    {
+        uint16_t count;
+        uint8_t validMask;
+        int16_t avg[TemperaturePoint::MAX_SLOTS];
+        int16_t min[TemperaturePoint::MAX_SLOTS];
+        int16_t max[TemperaturePoint::MAX_SLOTS];
+    };
+
+    struct Ring
+    {
+        Cell* cells = nullptr;
+        uint32_t newest = 0;    // bucket number (timestamp / period) of the newest cell
+        bool empty = true;
+    };
+
+    ServiceProvider& serviceProvider_;
+    LogManager& logManager_;
+    InitState initState_;
+    mutable Mutex mutex_;
+    Ring rings_[TIER_COUNT];
+
+    void Insert(size_t tier, const TemperaturePoint& sample);
+    void PreWarm();
+
+    static TemperaturePoint ToPoint(const Cell& cell, uint32_t timestamp);
+    static void FromPoint(const TemperaturePoint& point, Cell& cell);
+};
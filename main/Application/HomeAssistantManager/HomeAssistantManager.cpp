@@ -2,6 +2,7 @@
 #include "MqttManager/MqttManager.h"
 #include "DeviceManager/DeviceManager.h"
 #include "SensorManager/SensorManager.h"
+#include "RollingStats/RollingStats.h"
 #include "JsonWriter.h"
 #include "BufferStream.h"
 #include "esp_log.h"
@@ -57,74 +58,134 @@ void HomeAssistantManager::Init()
 
     // ── Temperature sensor entities ─────────────────────────
 
+    // The four colour channels are always announced; other ids once they
+    // have a sensor assigned (PublishTemperatures picks up later ones).
     mqtt.RegisterDiscovery([this]()
     {
-        auto &mqtt = serviceProvider_.getMqttManager();
-
-        char stateTopic[128];
-        snprintf(stateTopic, sizeof(stateTopic), "%s/temperatures", mqtt.GetBaseTopic());
-
-        for (int i = 0; i < MAX_SENSORS; i++)
+        discoveredMask_ = 0;
+        SensorSnapshot snap = serviceProvider_.getSensorManager().GetSnapshot();
+        for (int i = 0; i < (int)SensorManager::MAX_SENSORS; i++)
         {
-            char objectId[16];
-            snprintf(objectId, sizeof(objectId), "temp_%d", i);
-
-            char name[32];
-            snprintf(name, sizeof(name), "Temperature %s", SLOT_NAMES[i]);
-
-            char valTpl[48];
-            snprintf(valTpl, sizeof(valTpl), "{{ value_json.t%d }}", i);
-
-            mqtt.PublishEntityDiscovery("sensor", objectId, [&](JsonWriter &json)
-            {
-                json.field("name", name);
-
-                json.field("stat_t", stateTopic);
-                json.field("val_tpl", valTpl);
-                json.field("dev_cla", "temperature");
-                json.field("unit_of_meas", "\u00b0C");
-                json.field("sug_dsp_prc", static_cast<int32_t>(1));
-            });
+            if (i < (int)SensorManager::CHANNEL_COUNT || snap.address[i] != 0)
+                PublishSensorDiscovery(i);
         }
 
         PublishTemperatures();
+        PublishStats();
     });
 
-    publishTimer_.Init("ha_temp", pdMS_TO_TICKS(30000), true);
-    publishTimer_.SetHandler([this]()
-    {
-        PublishTemperatures();
-    });
-    publishTimer_.Start();
+    publishTask_.Init("HaPublish", 3, 6144);     // discovery nests a 1 KB payload under PublishTemperatures
+    publishTask_.SetHandler([this]() { PublishWork(); });
+    publishTask_.Run();
+    serviceProvider_.getSensorManager().Subscribe(publishTask_, NOTIFY_READING);
 
     init.SetReady();
     ESP_LOGI(TAG, "Initialized");
 }
 
+void HomeAssistantManager::PublishWork()
+{
+    // Woken by every read cycle; publishes the first one of each interval,
+    // so state updates carry fresh data and stop when the sensors do
+    TickType_t lastPublish = 0;
+    bool published = false;
+
+    while (true)
+    {
+        publishTask_.NotifyWait(nullptr, portMAX_DELAY);
+
+        TickType_t now = xTaskGetTickCount();
+        if (published && now - lastPublish < PUBLISH_INTERVAL)
+            continue;
+
+        // One after the other, so their 1 KB JSON buffers never share the stack
+        PublishTemperatures();
+        PublishStats();
+        lastPublish = now;
+        published = true;
+    }
+}
+
 void HomeAssistantManager::PublishLedState()
 {
     bool on = serviceProvider_.getDeviceManager().getLed().IsOn();
     serviceProvider_.getMqttManager().Publish("led/state", on ? "ON" : "OFF", true);
 }
 
+void HomeAssistantManager::PublishSensorDiscovery(int id)
+{
+    auto &mqtt = serviceProvider_.getMqttManager();
+
+    char stateTopic[128];
+    snprintf(stateTopic, sizeof(stateTopic), "%s/temperatures", mqtt.GetBaseTopic());
+
+    char objectId[16];
+    snprintf(objectId, sizeof(objectId), "temp_%d", id);
+
+    char name[32];
+    if (id < (int)SensorManager::CHANNEL_COUNT)
+        snprintf(name, sizeof(name), "Temperature %s", SLOT_NAMES[id]);
+    else
+        snprintf(name, sizeof(name), "Temperature %d", id + 1);
+
+    char valTpl[48];
+    snprintf(valTpl, sizeof(valTpl), "{{ value_json.t%d }}", id);
+
+    char statsTopic[128];
+    snprintf(statsTopic, sizeof(statsTopic), "%s/stats", mqtt.GetBaseTopic());
+
+    char attrTpl[48];
+    snprintf(attrTpl, sizeof(attrTpl), "{{ value_json.t%d | tojson }}", id);
+
+    mqtt.PublishEntityDiscovery("sensor", objectId, [&](JsonWriter &json)
+    {
+        json.field("name", name);
+
+        json.field("stat_t", stateTopic);
+        json.field("val_tpl", valTpl);
+        json.field("dev_cla", "temperature");
+        json.field("unit_of_meas", "\u00b0C");
+        json.field("sug_dsp_prc", static_cast<int32_t>(1));
+
+        // Rolling min/max/mean/stddev of the colour channels as attributes
+        if (id < (int)SensorManager::CHANNEL_COUNT)
+        {
+            json.field("json_attr_t", statsTopic);
+            json.field("json_attr_tpl", attrTpl);
+        }
+    });
+    discoveredMask_ |= (1ull << id);
+}
+
 void HomeAssistantManager::PublishTemperatures()
 {
     auto &mqtt = serviceProvider_.getMqttManager();
     if (!mqtt.IsConnected())
         return;
 
-    auto &sensors = serviceProvider_.getSensorManager();
+    SensorSnapshot snap = serviceProvider_.getSensorManager().GetSnapshot();
 
-    char buf[128];
+    // Announce sensors assigned since the last discovery round
+    for (int i = SensorManager::CHANNEL_COUNT; i < (int)SensorManager::MAX_SENSORS; i++)
+    {
+        if (snap.address[i] != 0 && !((discoveredMask_ >> i) & 1))
+            PublishSensorDiscovery(i);
+    }
+
+    // "tNN":-123.45, per sensor
+    char buf[16 + SensorManager::MAX_SENSORS * 16];
     BufferStream stream(buf, sizeof(buf));
     JsonWriter json(stream);
     json.beginObject();
-    for (int i = 0; i < MAX_SENSORS; i++)
+    for (int i = 0; i < (int)SensorManager::MAX_SENSORS; i++)
     {
+        if (i >= (int)SensorManager::CHANNEL_COUNT && snap.address[i] == 0)
+            continue;
+
         char key[4];
         snprintf(key, sizeof(key), "t%d", i);
-        if (sensors.IsSlotActive(i))
-            json.field(key, sensors.GetTemperature(i));
+        if (snap.IsActive(i))
+            json.field(key, snap.temperatureC[i]);
         else
             json.nullField(key);
     }
@@ -132,3 +193,44 @@ void HomeAssistantManager::PublishTemperatures()
 
     mqtt.Publish("temperatures", buf);
 }
+
+void HomeAssistantManager::PublishStats()
+{
+    auto &mqtt = serviceProvider_.getMqttManager();
+    if (!mqtt.IsConnected())
+        return;
+
+    auto &stats = serviceProvider_.getRollingStats();
+
+    // "tN":{"min_1h":..,"max_1h":..,"mean_1h":..,"sd_1h":..,...}, per channel
+    char buf[32 + RollingStats::SLOTS * (8 + RollingStats::WINDOW_COUNT * 4 * 20)];
+    BufferStream stream(buf, sizeof(buf));
+    JsonWriter json(stream);
+    json.beginObject();
+    for (size_t slot = 0; slot < RollingStats::SLOTS; slot++)
+    {
+        char key[16];
+        snprintf(key, sizeof(key), "t%u", (unsigned)slot);
+        json.fieldObject(key);
+        for (size_t w = 0; w < RollingStats::WINDOW_COUNT; w++)
+        {
+            RollingStats::Stats s;
+            if (!stats.Get(slot, w, s))
+                continue;
+
+            const char *name = RollingStats::WINDOWS[w].name;
+            snprintf(key, sizeof(key), "min_%s", name);
+            json.field(key, s.min);
+            snprintf(key, sizeof(key), "max_%s", name);
+            json.field(key, s.max);
+            snprintf(key, sizeof(key), "mean_%s", name);
+            json.field(key, s.mean);
+            snprintf(key, sizeof(key), "sd_%s", name);
+            json.field(key, s.stddev);
+        }
+        json.endObject();
+    }
+    json.endObject();
+
+    mqtt.Publish("stats", buf);
+}
@@ -2,11 +2,13 @@
 
 #include "ServiceProvider.h"
 #include "InitState.h"
-#include "Timer.h"
+#include "Task.h"
 
 class HomeAssistantManager
 {
     static constexpr const char *TAG = "HomeAssistantManager";
+    static constexpr uint32_t NOTIFY_READING = 1u << 0;
+    static constexpr TickType_t PUBLISH_INTERVAL = pdMS_TO_TICKS(30000);
 
 public:
     explicit HomeAssistantManager(ServiceProvider &serviceProvider);
@@ -24,10 +26,13 @@ private:
     ServiceProvider &serviceProvider_;
     InitState initState_;
 
-    static constexpr int MAX_SENSORS = 4;
     static constexpr const char *SLOT_NAMES[] = {"Red", "Blue", "Green", "Yellow"};
 
-    Timer publishTimer_;
+    Task publishTask_;
+    uint64_t discoveredMask_ = 0;   // sensor ids with a published discovery config
 
+    void PublishWork();
     void PublishLedState();
+    void PublishSensorDiscovery(int id);
+    void PublishStats();
 };
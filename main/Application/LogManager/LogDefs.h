@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 enum class LogKeys : uint8_t
@@ -12,8 +13,38 @@ enum class LogKeys : uint8_t
     Temperature_4,
     IpAddress,
     FirmwareVersion,
+    SampleCount,
+    TemperatureRange_1,     // packed min/max: low 16 bits = min, high 16 bits = max (centi-°C)
+    TemperatureRange_2,
+    TemperatureRange_3,
+    TemperatureRange_4,
+    AlarmInfo,              // slot in the low byte, kind (0 = high, 1 = low, 2 = rate) in the next
+    AlarmValue,             // float: °C, or °C/min for a rate alarm
+
+    // Sensors past the four channels: key = SensorTemperature_0 + sensor id.
+    // Ids 0-3 keep using Temperature_1..4.
+    SensorTemperature_0 = 64,
+    SensorTemperature_Last = SensorTemperature_0 + 63,
 };
 
+/// Log key that holds the temperature of a sensor id.
+inline uint8_t TemperatureKeyForSensor(size_t sensorId)
+{
+    if (sensorId < 4)
+        return static_cast<uint8_t>(LogKeys::Temperature_1) + sensorId;
+    return static_cast<uint8_t>(LogKeys::SensorTemperature_0) + sensorId;
+}
+
+/// Sensor id stored under a temperature key, or -1 for any other key.
+inline int SensorForTemperatureKey(uint8_t key)
+{
+    if (key >= static_cast<uint8_t>(LogKeys::Temperature_1) && key <= static_cast<uint8_t>(LogKeys::Temperature_4))
+        return key - static_cast<uint8_t>(LogKeys::Temperature_1);
+    if (key >= static_cast<uint8_t>(LogKeys::SensorTemperature_0) + 4 && key <= static_cast<uint8_t>(LogKeys::SensorTemperature_Last))
+        return key - static_cast<uint8_t>(LogKeys::SensorTemperature_0);
+    return -1;
+}
+
 enum class LogCode : uint32_t
 {
     // System events
@@ -31,4 +62,8 @@ enum class LogCode : uint32_t
 
     // Sensor events
     TemperatureReading,
+    TemperatureRollup,
+    BurstCaptured,
+    AlarmRaised,
+    AlarmCleared,
 };
@@ -2,6 +2,7 @@
 #include "JsonWriter.h"
 #include "BufferStream.h"
 #include "esp_log.h"
+#include <cmath>
 #include <cstdio>
 
 LogManager::LogManager(ServiceProvider& serviceProvider)
@@ -38,6 +39,9 @@ void LogManager::Init()
         }
     }
 
+    for (auto& rollup : rollups_)
+        rollup.Init();
+
     initAttempt.SetReady();
     ESP_LOGI(TAG, "Initialized (%lu entries on flash)", (unsigned long)log_.entryCount());
 }
@@ -57,10 +61,104 @@ uint32_t LogManager::EntryCount() const
 bool LogManager::Erase()
 {
     LOCK(mutex_);
+    for (auto& rollup : rollups_)
+        rollup.Erase();
     if (!log_.format(KEY_SIZE, VALUE_SIZE)) return false;
     return log_.init();
 }
 
+// ── Rollups ──────────────────────────────────────────────────
+
+void LogManager::AppendRollupSample(const TemperaturePoint& sample)
+{
+    LOCK(mutex_);
+    if (!timeSynced_) return;
+
+    for (auto& rollup : rollups_)
+        rollup.AddSample(sample);
+}
+
+bool LogManager::SelectRollupTier(uint32_t resolutionSeconds, RollupTier& tier) const
+{
+    for (size_t i = ROLLUP_TIER_COUNT; i-- > 0;)
+    {
+        if (rollups_[i].IsMounted() && rollups_[i].PeriodSeconds() <= resolutionSeconds)
+        {
+            tier = static_cast<RollupTier>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t LogManager::EntryTimestamp(const EntryIterator& entry)
+{
+    for (uint32_t f = 0; f < entry.fieldCount(); f++)
+    {
+        if (entry.key<uint8_t>(f) == static_cast<uint8_t>(LogKeys::TimeStamp))
+            return entry.value<uint32_t>(f);
+    }
+    return 0;
+}
+
+bool LogManager::DecodeTemperaturePoint(const EntryIterator& entry, TemperaturePoint& out,
+                                        uint8_t* presentMask)
+{
+    out = TemperaturePoint{};
+    if (presentMask) *presentMask = 0;
+    bool isTemperature = false;
+    bool isRollup = false;
+
+    for (uint32_t f = 0; f < entry.fieldCount(); f++)
+    {
+        auto key = static_cast<LogKeys>(entry.key<uint8_t>(f));
+        uint32_t bits = entry.value<uint32_t>(f);
+
+        switch (key)
+        {
+        case LogKeys::TimeStamp:
+            out.timestamp = bits;
+            break;
+        case LogKeys::LogCode:
+            isRollup = bits == static_cast<uint32_t>(LogCode::TemperatureRollup);
+            isTemperature = isRollup || bits == static_cast<uint32_t>(LogCode::TemperatureReading);
+            break;
+        case LogKeys::SampleCount:
+            out.count = bits;
+            break;
+        case LogKeys::Temperature_1:
+        case LogKeys::Temperature_2:
+        case LogKeys::Temperature_3:
+        case LogKeys::Temperature_4:
+        {
+            size_t slot = static_cast<size_t>(key) - static_cast<size_t>(LogKeys::Temperature_1);
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            if (!std::isnan(value))
+                out.Set(slot, value);
+            if (presentMask) *presentMask |= (1u << slot);
+            break;
+        }
+        case LogKeys::TemperatureRange_1:
+        case LogKeys::TemperatureRange_2:
+        case LogKeys::TemperatureRange_3:
+        case LogKeys::TemperatureRange_4:
+        {
+            size_t slot = static_cast<size_t>(key) - static_cast<size_t>(LogKeys::TemperatureRange_1);
+            out.min[slot] = static_cast<int16_t>(bits & 0xFFFF);
+            out.max[slot] = static_cast<int16_t>(bits >> 16);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    if (!isRollup)
+        out.count = 1;
+    return isTemperature;
+}
+
 void LogManager::BroadcastLastEntry()
 {
     if (!broadcastFunc_ || broadcastFieldCount_ == 0) return;
@@ -84,6 +182,43 @@ void LogManager::BroadcastLastEntry()
     broadcastFunc_(stream.data(), stream.length(), broadcastCtx_);
 }
 
+bool LogManager::AppendEntry(const FieldPair* fields, size_t count)
+{
+    LOCK(mutex_);
+
+    if (!timeSynced_)
+    {
+        if (pendingCount_ >= MAX_PENDING_ENTRIES) return false;
+        auto& entry = pendingEntries_[pendingCount_];
+        entry.fieldCount = 0;
+        entry.uptimeUs = esp_timer_get_time();
+        for (size_t i = 0; i < count && entry.fieldCount < MAX_BROADCAST_FIELDS; i++)
+            entry.fields[entry.fieldCount++] = fields[i];
+        pendingCount_++;
+        return true;
+    }
+
+    broadcastFieldCount_ = 0;
+    if (!log_.beginEntry()) return false;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        uint8_t key = fields[i].key;
+        uint32_t value = fields[i].value;
+        if (broadcastFieldCount_ < MAX_BROADCAST_FIELDS)
+            broadcastFields_[broadcastFieldCount_++] = {key, value};
+        if (!log_.field(&key, &value, sizeof(value)))
+        {
+            log_.finishEntry();
+            return false;
+        }
+    }
+
+    if (!log_.finishEntry()) return false;
+    BroadcastLastEntry();
+    return true;
+}
+
 void LogManager::OnTimeSynced()
 {
     LOCK(mutex_);
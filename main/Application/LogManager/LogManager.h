@@ -5,6 +5,7 @@
 #include "LogDefs.h"
 #include "Mutex.h"
 #include "EspFlash.h"
+#include "RollupLog.h"
 #include "flash_log.h"
 #include "DateTime.h"
 #include "esp_timer.h"
@@ -20,6 +21,10 @@ class LogManager {
     static constexpr size_t MAX_PENDING_ENTRIES = 32;
 
 public:
+    /// Most fields AppendEntry() keeps for an entry buffered before time sync.
+    /// Callers with more fields should split them over several entries.
+    static constexpr size_t MAX_ENTRY_FIELDS = MAX_BROADCAST_FIELDS;
+
     explicit LogManager(ServiceProvider& serviceProvider);
 
     LogManager(const LogManager&) = delete;
@@ -55,6 +60,10 @@ public:
         return true;
     }
 
+    /// Append a log entry from a runtime-built field list (e.g. only the slots
+    /// that changed). Same buffering and broadcast behavior as Append().
+    bool AppendEntry(const FieldPair* fields, size_t count);
+
     /// Called when time becomes available. Flushes buffered entries.
     void OnTimeSynced();
 
@@ -82,6 +91,124 @@ public:
     uint32_t EntryCount() const;
     bool Erase();
 
+    // ── Rollups ──────────────────────────────────────────────
+
+    enum class RollupTier : uint8_t { Minute, Hour, Day };
+    static constexpr size_t ROLLUP_TIER_COUNT = 3;
+
+    /// Fold a temperature sample into every rollup tier. Samples taken before
+    /// time sync are dropped (they have no usable bucket).
+    void AppendRollupSample(const TemperaturePoint& sample);
+
+    ReadView ReadRollup(RollupTier tier) const
+    {
+        return ReadView(rollups_[static_cast<size_t>(tier)].Log(), mutex_);
+    }
+
+    uint32_t RollupPeriod(RollupTier tier) const
+    {
+        return rollups_[static_cast<size_t>(tier)].PeriodSeconds();
+    }
+
+    /// Pick the coarsest tier whose bucket still meets `resolutionSeconds`.
+    /// Returns false if raw samples are needed.
+    bool SelectRollupTier(uint32_t resolutionSeconds, RollupTier& tier) const;
+
+    /// Decode a TemperatureReading or TemperatureRollup entry. Returns false
+    /// for any other entry type. `presentMask` (optional) gets a bit for every
+    /// slot that has a temperature field, including logged NaNs.
+    static bool DecodeTemperaturePoint(const EntryIterator& entry, TemperaturePoint& out,
+                                       uint8_t* presentMask = nullptr);
+
+    static uint32_t EntryTimestamp(const EntryIterator& entry);
+
+    /// Visit entries oldest-first; stop early when `fn` returns false.
+    /// The log is a ring, so storage order is [newest run][oldest run] and
+    /// the first backwards step in TimeStamp marks the seam. Two passes.
+    template<typename F>
+    static void ForEachChronological(const ReadView& view, F&& fn)
+    {
+        uint32_t prev = 0;
+        size_t seam = 0;
+        size_t idx = 0;
+        bool pastSeam = false;
+
+        for (auto entry : view)
+        {
+            uint32_t ts = EntryTimestamp(entry);
+            if (!pastSeam && ts != 0 && ts < prev)
+            {
+                pastSeam = true;
+                seam = idx;
+            }
+            if (ts != 0) prev = ts;
+            if (pastSeam && !fn(entry)) return;
+            idx++;
+        }
+
+        idx = 0;
+        for (auto entry : view)
+        {
+            if (pastSeam && idx >= seam) break;
+            if (!fn(entry)) return;
+            idx++;
+        }
+    }
+
+    /// Visit raw temperature samples oldest-first, rebuilding the full series
+    /// from a change-driven log. A slot missing from an entry keeps its last
+    /// logged value (a logged NaN clears it), and gaps up to `maxGapSeconds`
+    /// are filled on the `stepSeconds` grid. Longer gaps (device off) are not
+    /// bridged. Stop early when `fn` returns false.
+    template<typename F>
+    static void ForEachReconstructed(const ReadView& view, uint32_t stepSeconds,
+                                     uint32_t maxGapSeconds, F&& fn)
+    {
+        if (stepSeconds == 0) stepSeconds = 1;
+        TemperaturePoint carry;
+        bool haveCarry = false;
+
+        ForEachChronological(view, [&](const EntryIterator& entry) {
+            TemperaturePoint point;
+            uint8_t present = 0;
+            if (!DecodeTemperaturePoint(entry, point, &present) || point.timestamp == 0)
+                return true;
+            if (present == 0)
+                return true;    // only carries sensors past the charted channels
+
+            if (haveCarry && point.timestamp > carry.timestamp)
+            {
+                if (point.timestamp - carry.timestamp <= maxGapSeconds)
+                {
+                    for (uint32_t ts = carry.timestamp + stepSeconds; ts < point.timestamp; ts += stepSeconds)
+                    {
+                        TemperaturePoint fill = carry;
+                        fill.timestamp = ts;
+                        if (!fn(fill)) return false;
+                    }
+                }
+                else
+                {
+                    carry.validMask = 0;
+                }
+            }
+
+            for (size_t s = 0; s < TemperaturePoint::MAX_SLOTS; s++)
+            {
+                if (((present >> s) & 1) || !carry.IsValid(s))
+                    continue;
+                point.avg[s] = carry.avg[s];
+                point.min[s] = carry.min[s];
+                point.max[s] = carry.max[s];
+                point.validMask |= (1u << s);
+            }
+
+            carry = point;
+            haveCarry = true;
+            return fn(point);
+        });
+    }
+
 private:
     ServiceProvider& serviceProvider_;
     InitState initState_;
@@ -90,6 +217,12 @@ private:
     FlashLog log_{flash_};
     bool timeSynced_ = false;
 
+    RollupLog rollups_[ROLLUP_TIER_COUNT] = {
+        {"rollup_min", 60},
+        {"rollup_hour", 3600},
+        {"rollup_day", 86400},
+    };
+
     BroadcastFunc broadcastFunc_ = nullptr;
     void* broadcastCtx_ = nullptr;
 
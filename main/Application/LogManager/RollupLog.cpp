@@ -0,0 +1,161 @@
+#include "RollupLog.h"
+#include "esp_log.h"
+#include <cmath>
+#include <cstring>
+
+// ── TemperaturePoint ─────────────────────────────────────────
+
+int16_t TemperaturePoint::ToCenti(float celsius)
+{
+    float centi = std::round(celsius * 100.0f);
+    if (centi > INT16_MAX) return INT16_MAX;
+    if (centi < INT16_MIN) return INT16_MIN;
+    return static_cast<int16_t>(centi);
+}
+
+void TemperaturePoint::Merge(const TemperaturePoint& other)
+{
+    uint32_t total = count + other.count;
+    for (size_t s = 0; s < MAX_SLOTS; s++)
+    {
+        if (!other.IsValid(s))
+            continue;
+
+        if (!IsValid(s) || total == 0)
+        {
+            avg[s] = other.avg[s];
+            min[s] = other.min[s];
+            max[s] = other.max[s];
+            validMask |= (1u << s);
+            continue;
+        }
+
+        int64_t weighted = static_cast<int64_t>(avg[s]) * count
+                         + static_cast<int64_t>(other.avg[s]) * other.count;
+        avg[s] = static_cast<int16_t>(weighted / total);
+        if (other.min[s] < min[s]) min[s] = other.min[s];
+        if (other.max[s] > max[s]) max[s] = other.max[s];
+    }
+    if (timestamp == 0)
+        timestamp = other.timestamp;
+    count = total;
+}
+
+// ── RollupLog ────────────────────────────────────────────────
+
+RollupLog::RollupLog(const char* partitionLabel, uint32_t periodSeconds)
+    : label_(partitionLabel)
+    , periodSeconds_(periodSeconds)
+{
+}
+
+bool RollupLog::Init()
+{
+    if (!flash_.mount(label_))
+    {
+        ESP_LOGE(TAG, "Failed to mount '%s'", label_);
+        return false;
+    }
+
+    if (!log_.init())
+    {
+        ESP_LOGI(TAG, "No valid rollup in '%s', formatting", label_);
+        if (!log_.format(KEY_SIZE, VALUE_SIZE) || !log_.init())
+        {
+            ESP_LOGE(TAG, "Format of '%s' failed", label_);
+            return false;
+        }
+    }
+
+    mounted_ = true;
+    ESP_LOGI(TAG, "'%s': %lus buckets, %lu entries, ~%lu days retention",
+             label_, (unsigned long)periodSeconds_, (unsigned long)log_.entryCount(),
+             (unsigned long)(RetentionSeconds() / 86400));
+    return true;
+}
+
+bool RollupLog::Erase()
+{
+    if (!mounted_) return false;
+    ResetBucket(0);
+    if (!log_.format(KEY_SIZE, VALUE_SIZE)) return false;
+    return log_.init();
+}
+
+uint32_t RollupLog::RetentionSeconds() const
+{
+    // Worst case entry: TimeStamp, LogCode, SampleCount + avg/range per slot
+    constexpr size_t fields = 3 + 2 * TemperaturePoint::MAX_SLOTS;
+    constexpr size_t entryBytes = fields * (1 + KEY_SIZE + VALUE_SIZE);
+    size_t usable = flash_.totalSize() - 2 * sizeof(FlashLogHeader);
+    return static_cast<uint32_t>(usable / entryBytes) * periodSeconds_;
+}
+
+void RollupLog::AddSample(const TemperaturePoint& sample)
+{
+    if (!mounted_ || sample.timestamp == 0 || sample.count == 0)
+        return;
+
+    uint32_t bucket = sample.timestamp - (sample.timestamp % periodSeconds_);
+    if (bucket != bucketStart_)
+    {
+        Flush();
+        ResetBucket(bucket);
+    }
+
+    bucketCount_ += sample.count;
+    for (size_t s = 0; s < TemperaturePoint::MAX_SLOTS; s++)
+    {
+        if (!sample.IsValid(s))
+            continue;
+
+        if (slotCount_[s] == 0 || sample.min[s] < min_[s]) min_[s] = sample.min[s];
+        if (slotCount_[s] == 0 || sample.max[s] > max_[s]) max_[s] = sample.max[s];
+        sum_[s] += static_cast<int64_t>(sample.avg[s]) * sample.count;
+        slotCount_[s] += sample.count;
+    }
+}
+
+void RollupLog::ResetBucket(uint32_t bucketStart)
+{
+    bucketStart_ = bucketStart;
+    bucketCount_ = 0;
+    memset(sum_, 0, sizeof(sum_));
+    memset(slotCount_, 0, sizeof(slotCount_));
+}
+
+void RollupLog::Flush()
+{
+    if (bucketStart_ == 0 || bucketCount_ == 0)
+        return;
+
+    auto put = [this](LogKeys key, uint32_t bits) {
+        auto k = static_cast<uint8_t>(key);
+        return log_.field(&k, &bits, sizeof(bits));
+    };
+
+    if (!log_.beginEntry()) return;
+
+    bool ok = put(LogKeys::TimeStamp, bucketStart_)
+           && put(LogKeys::LogCode, static_cast<uint32_t>(LogCode::TemperatureRollup))
+           && put(LogKeys::SampleCount, bucketCount_);
+
+    for (size_t s = 0; s < TemperaturePoint::MAX_SLOTS && ok; s++)
+    {
+        if (slotCount_[s] == 0)
+            continue;
+
+        float avg = TemperaturePoint::FromCenti(static_cast<int16_t>(sum_[s] / slotCount_[s]));
+        uint32_t avgBits;
+        memcpy(&avgBits, &avg, sizeof(avgBits));
+        uint32_t range = static_cast<uint16_t>(min_[s])
+                       | (static_cast<uint32_t>(static_cast<uint16_t>(max_[s])) << 16);
+
+        ok = put(static_cast<LogKeys>(static_cast<uint8_t>(LogKeys::Temperature_1) + s), avgBits)
+          && put(static_cast<LogKeys>(static_cast<uint8_t>(LogKeys::TemperatureRange_1) + s), range);
+    }
+
+    log_.finishEntry();
+    if (!ok)
+        ESP_LOGW(TAG, "'%s': failed to write bucket %lu", label_, (unsigned long)bucketStart_);
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "EspFlash.h"
+#include "flash_log.h"
+#include "LogDefs.h"
+#include <cstdint>
+
+/// One temperature sample or aggregated bucket, decoded from the raw log or a
+/// rollup tier. Temperatures are stored as centi-°C to keep the struct small.
+struct TemperaturePoint
+{
+    static constexpr size_t MAX_SLOTS = 4;
+
+    uint32_t timestamp = 0;     // UTC seconds (bucket start for rollups)
+    uint32_t count = 0;         // samples folded into this point
+    uint8_t validMask = 0;      // bit n set = slot n has data
+    int16_t avg[MAX_SLOTS] = {};
+    int16_t min[MAX_SLOTS] = {};
+    int16_t max[MAX_SLOTS] = {};
+
+    bool IsValid(size_t slot) const { return (validMask >> slot) & 1; }
+
+    void Set(size_t slot, float celsius)
+    {
+        int16_t centi = ToCenti(celsius);
+        avg[slot] = min[slot] = max[slot] = centi;
+        validMask |= (1u << slot);
+    }
+
+    /// Fold another point into this one (count-weighted average, min/max envelope).
+    void Merge(const TemperaturePoint& other);
+
+    static int16_t ToCenti(float celsius);
+    static float FromCenti(int16_t centi) { return centi / 100.0f; }
+};
+
+/// Downsampled temperature stream on its own flash partition.
+///
+/// Samples are folded into a bucket of `periodSeconds`. When a sample lands in
+/// another bucket, the finished one is written as a single entry: TimeStamp
+/// (bucket start), LogCode::TemperatureRollup, SampleCount and, per slot with
+/// data, Temperature_n (average) plus TemperatureRange_n (packed min/max).
+/// Retention is whatever the partition holds. Not thread-safe; LogManager
+/// serializes access with its mutex.
+class RollupLog
+{
+    static constexpr const char* TAG = "RollupLog";
+    static constexpr size_t KEY_SIZE = sizeof(uint8_t);
+    static constexpr size_t VALUE_SIZE = sizeof(uint32_t);
+
+public:
+    RollupLog(const char* partitionLabel, uint32_t periodSeconds);
+
+    RollupLog(const RollupLog&) = delete;
+    RollupLog& operator=(const RollupLog&) = delete;
+
+    bool Init();
+    bool Erase();
+    bool IsMounted() const { return mounted_; }
+
+    const char* Label() const { return label_; }
+    uint32_t PeriodSeconds() const { return periodSeconds_; }
+    uint32_t RetentionSeconds() const;
+    const FlashLog& Log() const { return log_; }
+
+    void AddSample(const TemperaturePoint& sample);
+
+private:
+    const char* label_;
+    uint32_t periodSeconds_;
+    bool mounted_ = false;
+    EspFlash flash_;
+    FlashLog log_{flash_};
+
+    // Bucket being accumulated (bucketStart == 0 means empty)
+    uint32_t bucketStart_ = 0;
+    uint32_t bucketCount_ = 0;
+    int64_t sum_[TemperaturePoint::MAX_SLOTS] = {};
+    uint32_t slotCount_[TemperaturePoint::MAX_SLOTS] = {};
+    int16_t min_[TemperaturePoint::MAX_SLOTS] = {};
+    int16_t max_[TemperaturePoint::MAX_SLOTS] = {};
+
+    void Flush();
+    void ResetBucket(uint32_t bucketStart);
+};
@@ -1,14 +1,25 @@
 #include "MonitorManager.h"
+#include "HistoryCache/HistoryCache.h"
 #include "LogManager/LogManager.h"
+#include "RollingStats/RollingStats.h"
 #include "SensorManager/SensorManager.h"
 #include "SettingsManager/SettingsManager.h"
+#include "TimeManager/TimeManager.h"
 #include "esp_log.h"
+#include <sys/time.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 
 MonitorManager::MonitorManager(ServiceProvider& serviceProvider)
     : serviceProvider_(serviceProvider)
     , logManager_(serviceProvider.getLogManager())
+    , historyCache_(serviceProvider.getHistoryCache())
+    , rollingStats_(serviceProvider.getRollingStats())
     , sensorManager_(serviceProvider.getSensorManager())
     , settingsManager_(serviceProvider.getSettingsManager())
+    , timeManager_(serviceProvider.getTimeManager())
 {
 }
 
@@ -20,27 +31,189 @@ void MonitorManager::Init()
         return;
     }
 
-    int32_t rateSec = settingsManager_.getInt("monitor.rate", DEFAULT_RATE_SECONDS);
-    if (rateSec < 1) rateSec = 1;
+    rateSeconds_ = settingsManager_.getInt("monitor.rate", DEFAULT_RATE_SECONDS);
+    if (rateSeconds_ < 1) rateSeconds_ = 1;
 
-    sampleTimer_.Init("Monitor", pdMS_TO_TICKS(rateSec * 1000), true);
-    sampleTimer_.SetHandler([this]() { TakeSample(); });
-    sampleTimer_.Start();
+    deadbandCenti_ = settingsManager_.getInt("log.deadband", DEFAULT_DEADBAND_CENTI);
+    heartbeatSeconds_ = settingsManager_.getInt("log.heartbeat", DEFAULT_HEARTBEAT_SECONDS);
+    if (heartbeatSeconds_ < rateSeconds_) heartbeatSeconds_ = rateSeconds_;
+
+    task_.Init("Monitor", 5, 4096);
+    task_.SetHandler([this]() { Work(); });
+    task_.Run();
+    sensorManager_.Subscribe(task_, NOTIFY_READING);
 
     initAttempt.SetReady();
-    ESP_LOGI(TAG, "Initialized (rate: %lds)", rateSec);
+    ESP_LOGI(TAG, "Initialized (rate: %lds, deadband: %ld.%02ld°C, heartbeat: %lds)",
+             rateSeconds_, deadbandCenti_ / 100, deadbandCenti_ % 100, heartbeatSeconds_);
+}
+
+// ── Sampler loop ─────────────────────────────────────────────
+
+static int64_t WallClockUs()
+{
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return static_cast<int64_t>(tv.tv_sec) * 1000000 + tv.tv_usec;
 }
 
-void MonitorManager::TakeSample()
+void MonitorManager::Work()
 {
-    logManager_.Append(
-        LogKeys::TimeStamp, DateTime::Now(),
-        LogKeys::LogCode, static_cast<uint32_t>(LogCode::TemperatureReading),
-        LogKeys::Temperature_1, sensorManager_.GetTemperature(0),
-        LogKeys::Temperature_2, sensorManager_.GetTemperature(1),
-        LogKeys::Temperature_3, sensorManager_.GetTemperature(2),
-        LogKeys::Temperature_4, sensorManager_.GetTemperature(3)
-    );
+    const int64_t rateUs = static_cast<int64_t>(rateSeconds_) * 1000000;
+
+    // Deadlines sit on the wall-clock grid (e.g. :00, :10, :20 at 10 s), so
+    // sample timestamps are exact multiples of the rate and never drift.
+    int64_t deadline = (WallClockUs() / rateUs + 1) * rateUs;
+
+    while (true)
+    {
+        int64_t now = WallClockUs();
+        if (now < deadline - rateUs || now > deadline + 60 * rateUs)
+        {
+            // Clock was stepped — re-align instead of reporting misses
+            stats_.clockSteps++;
+            deadline = (now / rateUs + 1) * rateUs;
+        }
+
+        if (now < deadline)
+        {
+            // Round up so we never wake before the deadline. Readings that
+            // arrive earlier only cut the sleep short.
+            int64_t waitMs = (deadline - now + 999) / 1000;
+            task_.NotifyWait(nullptr, pdMS_TO_TICKS(waitMs) + 1);
+            continue;
+        }
 
+        int64_t lateUs = now - deadline;
+        if (lateUs >= rateUs)
+        {
+            uint32_t missed = static_cast<uint32_t>(lateUs / rateUs);
+            stats_.missedDeadlines += missed;
+            deadline += missed * rateUs;
+            lateUs -= missed * rateUs;
+            ESP_LOGW(TAG, "Missed %lu sample deadline(s)", (unsigned long)missed);
+        }
+
+        // Sample the first read cycle that completes after the deadline, so
+        // the log holds a fresh reading rather than whatever was current when
+        // the task woke. Wait at most half a period for it.
+        int64_t graceUs = std::min<int64_t>(FRESH_READING_TIMEOUT_MS * 1000, rateUs / 2) - lateUs;
+        if (graceUs <= 0 || !task_.NotifyWait(nullptr, pdMS_TO_TICKS((graceUs + 999) / 1000)))
+            stats_.staleSamples++;
+        lateUs = WallClockUs() - deadline;
+
+        stats_.lastLatenessMs = static_cast<uint32_t>(lateUs / 1000);
+        if (stats_.lastLatenessMs > stats_.maxLatenessMs)
+            stats_.maxLatenessMs = stats_.lastLatenessMs;
+
+        TakeSample(static_cast<uint32_t>(deadline / 1000000));
+        stats_.samples++;
+        deadline += rateUs;
+    }
 }
 
+void MonitorManager::TakeSample(uint32_t timestamp)
+{
+    SensorSnapshot snap = sensorManager_.GetSnapshot();
+
+    // Rollups, the RAM cache and the rolling stats follow the colour channels
+    TemperaturePoint sample;
+    sample.timestamp = timestamp;
+    sample.count = 1;
+    for (size_t i = 0; i < TemperaturePoint::MAX_SLOTS; i++)
+    {
+        if (snap.IsActive(i))
+            sample.Set(i, snap.temperatureC[i]);
+    }
+
+    logManager_.AppendRollupSample(sample);
+    if (timeManager_.IsTimeValid())
+    {
+        // Stats first: their one-time pre-warm reads the cache up to, not
+        // including, this sample
+        rollingStats_.AddSample(sample);
+        historyCache_.AddSample(sample);
+    }
+
+    LogChangedSensors(timestamp, snap);
+}
+
+void MonitorManager::LogChangedSensors(uint32_t timestamp, const SensorSnapshot& snap)
+{
+    bool heartbeat = lastHeartbeat_ == 0
+                  || timestamp < lastHeartbeat_
+                  || timestamp - lastHeartbeat_ >= static_cast<uint32_t>(heartbeatSeconds_);
+
+    // Ids are visited in order, so the channels always land in the first entry.
+    // What an entry logs only becomes the reference once it is written; a
+    // failed append is retried on the next sample instead of being lost.
+    LogManager::FieldPair fields[LogManager::MAX_ENTRY_FIELDS];
+    struct Staged { uint8_t id; bool valid; int16_t centi; };
+    Staged staged[LogManager::MAX_ENTRY_FIELDS];
+    size_t count = 0;
+    size_t stagedCount = 0;
+    bool allWritten = true;
+    auto flush = [&]() {
+        if (count > 2)
+        {
+            if (logManager_.AppendEntry(fields, count))
+            {
+                stats_.entriesWritten++;
+                for (size_t n = 0; n < stagedCount; n++)
+                {
+                    const Staged& st = staged[n];
+                    loggedCenti_[st.id] = st.centi;
+                    if (st.valid) loggedMask_ |= (1ull << st.id);
+                    else loggedMask_ &= ~(1ull << st.id);
+                }
+            }
+            else
+                allWritten = false;
+        }
+        count = 0;
+        stagedCount = 0;
+    };
+
+    for (size_t i = 0; i < SensorManager::MAX_SENSORS; i++)
+    {
+        bool valid = snap.IsActive(i);
+        bool wasValid = (loggedMask_ >> i) & 1;
+        int16_t centi = valid ? TemperaturePoint::ToCenti(snap.temperatureC[i]) : 0;
+
+        bool write;
+        if (valid != wasValid)
+            write = true;   // sensor appeared or disappeared
+        else if (heartbeat)
+            write = i < SensorManager::CHANNEL_COUNT || snap.address[i] != 0;
+        else if (valid)
+            write = abs(centi - loggedCenti_[i]) > deadbandCenti_;
+        else
+            write = false;
+
+        if (!write)
+        {
+            if (valid) stats_.slotsSuppressed++;
+            continue;
+        }
+
+        if (count == 0)
+        {
+            fields[count++] = { static_cast<uint8_t>(LogKeys::TimeStamp), timestamp };
+            fields[count++] = { static_cast<uint8_t>(LogKeys::LogCode), static_cast<uint32_t>(LogCode::TemperatureReading) };
+        }
+
+        // Inactive sensors are logged as NaN so readers stop carrying the last value
+        float value = valid ? TemperaturePoint::FromCenti(centi) : NAN;
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        fields[count++] = { TemperatureKeyForSensor(i), bits };
+        staged[stagedCount++] = { static_cast<uint8_t>(i), valid, centi };
+
+        if (count == LogManager::MAX_ENTRY_FIELDS)
+            flush();
+    }
+    flush();
+
+    if (heartbeat && allWritten)
+        lastHeartbeat_ = timestamp;
+}
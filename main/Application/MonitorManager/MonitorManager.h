@@ -2,18 +2,26 @@
 
 #include "ServiceProvider.h"
 #include "InitState.h"
-#include "Timer.h"
+#include "Task.h"
+#include "RollupLog.h"
+#include "SensorManager.h"
 
+class HistoryCache;
 class LogManager;
-class SensorManager;
+class RollingStats;
 class SettingsManager;
+class TimeManager;
 
 class MonitorManager
 {
     static constexpr const char* TAG = "MonitorManager";
+    static constexpr uint32_t NOTIFY_READING = 1u << 0;
+    static constexpr int64_t FRESH_READING_TIMEOUT_MS = 2000;
 
 public:
     static constexpr int32_t DEFAULT_RATE_SECONDS = 10;
+    static constexpr int32_t DEFAULT_DEADBAND_CENTI = 10;       // 0.1 °C
+    static constexpr int32_t DEFAULT_HEARTBEAT_SECONDS = 600;
 
     explicit MonitorManager(ServiceProvider& serviceProvider);
 
@@ -22,13 +30,44 @@ public:
 
     void Init();
 
+    struct SamplerStats
+    {
+        uint32_t samples;
+        uint32_t missedDeadlines;   // grid slots skipped because the task woke too late
+        uint32_t lastLatenessMs;    // deadline to the fresh reading that was sampled, last sample
+        uint32_t maxLatenessMs;
+        uint32_t staleSamples;      // samples taken without a fresh reading (sensor task stalled)
+        uint32_t clockSteps;        // wall-clock jumps that forced a re-align (SNTP, manual set)
+        uint32_t entriesWritten;    // raw log entries actually written
+        uint32_t slotsSuppressed;   // slot values skipped because they stayed inside the deadband
+    };
+
+    SamplerStats GetSamplerStats() const { return stats_; }
+    int32_t GetRateSeconds() const { return rateSeconds_; }
+    int32_t GetHeartbeatSeconds() const { return heartbeatSeconds_; }
+
 private:
     ServiceProvider& serviceProvider_;
     LogManager& logManager_;
+    HistoryCache& historyCache_;
+    RollingStats& rollingStats_;
     SensorManager& sensorManager_;
     SettingsManager& settingsManager_;
+    TimeManager& timeManager_;
     InitState initState_;
-    Timer sampleTimer_;
+    Task task_;
+    int32_t rateSeconds_ = DEFAULT_RATE_SECONDS;
+    SamplerStats stats_ = {};
+
+    // Change-driven logging: a sensor is written when it leaves the deadband
+    // around its last logged value, or on the heartbeat (all assigned sensors).
+    int32_t deadbandCenti_ = DEFAULT_DEADBAND_CENTI;
+    int32_t heartbeatSeconds_ = DEFAULT_HEARTBEAT_SECONDS;
+    uint32_t lastHeartbeat_ = 0;
+    uint64_t loggedMask_ = 0;                             // sensors whose last logged value was a reading
+    int16_t loggedCenti_[SensorManager::MAX_SENSORS] = {};
 
-    void TakeSample();
+    void Work();
+    void TakeSample(uint32_t timestamp);
+    void LogChangedSensors(uint32_t timestamp, const SensorSnapshot& snap);
 };
@@ -340,7 +340,9 @@ void MqttManager::PublishEntityDiscovery(const char *component, const char *obje
     char uid[64];
     snprintf(uid, sizeof(uid), "thermy_%s_%s", deviceId_, objectId);
 
-    char buf[512];
+    // Worst case is a temperature sensor with a full-length base topic in
+    // avty_t, stat_t and json_attr_t: about 720 bytes
+    char buf[1024];
     BufferStream stream(buf, sizeof(buf));
     JsonWriter json(stream);
 
@@ -351,6 +353,13 @@ void MqttManager::PublishEntityDiscovery(const char *component, const char *obje
     writeFields(json);
     json.endObject();
 
+    // A truncated payload is invalid JSON, and retained, so don't send it
+    if (stream.length() >= sizeof(buf) - 1)
+    {
+        ESP_LOGE(TAG, "Discovery for %s/%s does not fit in %u bytes", component, objectId, (unsigned)sizeof(buf));
+        return;
+    }
+
     esp_mqtt_client_publish(client_, configTopic, buf, 0, 1, 1);
 }
 
@@ -132,6 +132,8 @@ void NetworkManager::FallbackToAP()
 
 void NetworkManager::HandleNetworkEvent(const NetworkEvent& event)
 {
+    statusGeneration_++;
+
     switch (event.type)
     {
     case NetworkEventType::LinkUp:
@@ -31,6 +31,10 @@ public:
 
     bool IsAccessPoint() const { return wifi_interface_.IsAP(); }
 
+    /// Bumps on every link or IP event, so callers can keep the result of
+    /// wifi().getStatus() until it changes instead of polling.
+    uint32_t GetStatusGeneration() const { return statusGeneration_.load(); }
+
 private:
     ServiceProvider& serviceProvider_;
 
@@ -42,6 +46,7 @@ private:
     char staPassword_[65] = {};
     std::atomic<int> staRetryCount_{0};
     std::atomic<bool> staConnected_{false};
+    std::atomic<uint32_t> statusGeneration_{0};
 
     Timer connectTimer_;
 
@@ -0,0 +1,213 @@
+#include "RollingStats.h"
+#include "HistoryCache.h"
+#include "esp_log.h"
+#include "esp_heap_caps.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+RollingStats::RollingStats(ServiceProvider& serviceProvider)
+    : serviceProvider_(serviceProvider)
+{
+}
+
+void RollingStats::Init()
+{
+    auto initAttempt = initState_.TryBeginInit();
+    if (!initAttempt)
+    {
+        return;
+    }
+
+    size_t totalBytes = 0;
+    for (size_t slot = 0; slot < SLOTS; slot++)
+    {
+        for (size_t i = 0; i < WINDOW_COUNT; i++)
+        {
+            // Buckets and both deques in one block; PSRAM with internal RAM fallback
+            size_t count = WINDOWS[i].bucketCount;
+            size_t bytes = count * (sizeof(Bucket) + 2 * sizeof(uint32_t));
+            auto* block = static_cast<uint8_t*>(
+                heap_caps_calloc(1, bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT));
+            if (!block)
+                block = static_cast<uint8_t*>(calloc(1, bytes));
+            assert(block && "Failed to allocate rolling stats window");
+
+            Window& w = windows_[slot][i];
+            w.buckets = reinterpret_cast<Bucket*>(block);
+            w.minQ.items = reinterpret_cast<uint32_t*>(block + count * sizeof(Bucket));
+            w.maxQ.items = w.minQ.items + count;
+            totalBytes += bytes;
+        }
+    }
+
+    initAttempt.SetReady();
+    ESP_LOGI(TAG, "Initialized (%u windows, %u KB)", (unsigned)WINDOW_COUNT, (unsigned)(totalBytes / 1024));
+}
+
+// ── Ingest ───────────────────────────────────────────────────
+
+void RollingStats::AddSample(const TemperaturePoint& sample)
+{
+    if (!initState_.IsReady() || sample.timestamp == 0 || sample.count == 0)
+        return;
+
+    LOCK(mutex_);
+    if (!prewarmed_)
+    {
+        prewarmed_ = true;
+        PreWarm(sample.timestamp);
+    }
+
+    for (size_t slot = 0; slot < SLOTS; slot++)
+        for (size_t i = 0; i < WINDOW_COUNT; i++)
+            Insert(slot, i, sample);
+}
+
+void RollingStats::Insert(size_t slot, size_t window, const TemperaturePoint& point)
+{
+    const auto& cfg = WINDOWS[window];
+    Window& w = windows_[slot][window];
+
+    // Expire old buckets even when this slot has no data, so a sensor that
+    // goes away drops out of the window on time
+    uint32_t bucket = point.timestamp / cfg.bucketSeconds;
+    if (!w.empty && bucket < w.newest)
+        return; // out of order; the deques only grow at the back
+    Advance(w, cfg, bucket);
+
+    if (!point.IsValid(slot))
+        return;
+
+    int64_t avg = point.avg[slot];
+    Bucket& b = w.buckets[bucket % cfg.bucketCount];
+    bool first = b.count == 0;
+    b.count += point.count;
+    b.sum += avg * point.count;
+    b.sumSq += avg * avg * point.count;
+    w.count += point.count;
+    w.sum += avg * point.count;
+    w.sumSq += avg * avg * point.count;
+
+    // This bucket is the newest, so it can only be at the back of a deque.
+    // Re-queue it when its extreme moved past the entries behind it.
+    if (first || point.min[slot] < b.min)
+    {
+        b.min = first ? point.min[slot] : std::min(b.min, point.min[slot]);
+        while (w.minQ.size > 0 && w.buckets[w.minQ.Back(cfg.bucketCount) % cfg.bucketCount].min >= b.min)
+            w.minQ.PopBack();
+        w.minQ.PushBack(cfg.bucketCount, bucket);
+    }
+    if (first || point.max[slot] > b.max)
+    {
+        b.max = first ? point.max[slot] : std::max(b.max, point.max[slot]);
+        while (w.maxQ.size > 0 && w.buckets[w.maxQ.Back(cfg.bucketCount) % cfg.bucketCount].max <= b.max)
+            w.maxQ.PopBack();
+        w.maxQ.PushBack(cfg.bucketCount, bucket);
+    }
+}
+
+void RollingStats::Advance(Window& w, const WindowConfig& cfg, uint32_t bucket)
+{
+    if (w.empty)
+    {
+        w.newest = bucket;
+        w.empty = false;
+        return;
+    }
+    if (bucket == w.newest)
+        return;
+
+    // Subtract the buckets that fall out of the window, then clear them.
+    // Bounded by the ring size, so a long gap costs at most one pass.
+    uint32_t gap = bucket - w.newest;
+    if (gap >= cfg.bucketCount)
+    {
+        memset(w.buckets, 0, cfg.bucketCount * sizeof(Bucket));
+        w.count = 0;
+        w.sum = 0;
+        w.sumSq = 0;
+        w.minQ.size = 0;
+        w.maxQ.size = 0;
+    }
+    else
+    {
+        for (uint32_t n = w.newest + 1; n <= bucket; n++)
+        {
+            Bucket& old = w.buckets[n % cfg.bucketCount];
+            w.count -= old.count;
+            w.sum -= old.sum;
+            w.sumSq -= old.sumSq;
+            old = Bucket{};
+        }
+
+        uint32_t oldest = bucket - (cfg.bucketCount - 1);
+        while (w.minQ.size > 0 && w.minQ.Front() < oldest)
+            w.minQ.PopFront(cfg.bucketCount);
+        while (w.maxQ.size > 0 && w.maxQ.Front() < oldest)
+            w.maxQ.PopFront(cfg.bucketCount);
+    }
+    w.newest = bucket;
+}
+
+void RollingStats::PreWarm(uint32_t timestamp)
+{
+    // Rebuild each window from the in-RAM history at the window's bucket
+    // size. Only bucket averages are known, so the variance of older data
+    // misses the spread within each bucket.
+    auto& history = serviceProvider_.getHistoryCache();
+    size_t maxCount = 0;
+    for (const auto& cfg : WINDOWS)
+        maxCount = std::max<size_t>(maxCount, cfg.bucketCount);
+
+    std::unique_ptr<TemperaturePoint[]> points(new (std::nothrow) TemperaturePoint[maxCount]);
+    if (!points)
+        return;
+
+    size_t total = 0;
+    for (size_t i = 0; i < WINDOW_COUNT; i++)
+    {
+        const auto& cfg = WINDOWS[i];
+        uint32_t newest = timestamp / cfg.bucketSeconds;
+        uint32_t from = newest >= cfg.bucketCount - 1
+                      ? (newest - (cfg.bucketCount - 1)) * cfg.bucketSeconds : 0;
+
+        size_t count = 0;
+        if (!history.Query(from, timestamp, cfg.bucketSeconds, points.get(), cfg.bucketCount, count))
+            continue;
+
+        for (size_t p = 0; p < count; p++)
+            for (size_t slot = 0; slot < SLOTS; slot++)
+                Insert(slot, i, points[p]);
+        total += count;
+    }
+
+    ESP_LOGI(TAG, "Pre-warmed from history: %u buckets", (unsigned)total);
+}
+
+// ── Query ────────────────────────────────────────────────────
+
+bool RollingStats::Get(size_t slot, size_t window, Stats& out) const
+{
+    out = Stats{};
+    if (!initState_.IsReady() || slot >= SLOTS || window >= WINDOW_COUNT)
+        return false;
+
+    LOCK(mutex_);
+    const auto& cfg = WINDOWS[window];
+    const Window& w = windows_[slot][window];
+    if (w.count == 0 || w.minQ.size == 0 || w.maxQ.size == 0)
+        return false;
+
+    double n = w.count;
+    double mean = w.sum / n;
+    double variance = w.sumSq / n - mean * mean;
+
+    out.count = w.count;
+    out.min = TemperaturePoint::FromCenti(w.buckets[w.minQ.Front() % cfg.bucketCount].min);
+    out.max = TemperaturePoint::FromCenti(w.buckets[w.maxQ.Front() % cfg.bucketCount].max);
+    out.mean = static_cast<float>(mean / 100.0);
+    out.stddev = variance > 0.0 ? static_cast<float>(std::sqrt(variance) / 100.0) : 0.0f;
+    return true;
+}
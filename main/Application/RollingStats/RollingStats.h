@@ -0,0 +1,108 @@
+#pragma once
+
+#include "ServiceProvider.h"
+#include "InitState.h"
+#include "Mutex.h"
+#include "RollupLog.h"
+#include <cstdint>
+
+/// Sliding-window min/max/mean/stddev per colour channel over the last hour,
+/// day and week.
+///
+/// A window is a ring of buckets (min, max, count, sum, sum of squares).
+/// Running totals over the ring give the mean and variance, and a monotonic
+/// deque of bucket numbers per direction gives the min and max, so adding a
+/// sample and querying a window are both O(1) (amortized for the deques).
+/// Sums are exact integers in centi-°C, so buckets leaving the window are
+/// subtracted without drift. A window spans its full bucket count, the
+/// newest (partial) bucket included.
+///
+/// Fed by MonitorManager on every sample once the clock is valid; the first
+/// sample pre-warms the windows from HistoryCache.
+class RollingStats
+{
+    static constexpr const char* TAG = "RollingStats";
+
+public:
+    struct WindowConfig { const char* name; uint32_t bucketSeconds; uint32_t bucketCount; };
+
+    // 60 × 1 min, 96 × 15 min, 168 × 1 h
+    static constexpr WindowConfig WINDOWS[] = {
+        { "1h",    60,  60 },
+        { "24h",  900,  96 },
+        { "7d",  3600, 168 },
+    };
+    static constexpr size_t WINDOW_COUNT = sizeof(WINDOWS) / sizeof(WINDOWS[0]);
+    static constexpr size_t SLOTS = TemperaturePoint::MAX_SLOTS;
+
+    struct Stats
+    {
+        uint32_t count = 0;     // samples in the window; 0 = no data
+        float min = 0.0f;
+        float max = 0.0f;
+        float mean = 0.0f;
+        float stddev = 0.0f;
+    };
+
+    explicit RollingStats(ServiceProvider& serviceProvider);
+
+    RollingStats(const RollingStats&) = delete;
+    RollingStats& operator=(const RollingStats&) = delete;
+
+    void Init();
+
+    /// Fold a sample (or an aggregated point) into every window. Thread-safe.
+    void AddSample(const TemperaturePoint& sample);
+
+    /// Statistics of one slot over one window. Returns false without data.
+    bool Get(size_t slot, size_t window, Stats& out) const;
+
+private:
+    struct Bucket
+    {
+        int64_t sumSq;
+        int32_t sum;
+        uint16_t count;
+        int16_t min;
+        int16_t max;
+    };
+
+    /// Ring of bucket numbers used as a monotonic deque; holds at most
+    /// bucketCount entries since each bucket appears once.
+    struct Deque
+    {
+        uint32_t* items = nullptr;
+        uint16_t head = 0;
+        uint16_t size = 0;
+
+        uint32_t Front() const { return items[head]; }
+        uint32_t Back(uint32_t capacity) const { return items[(head + size - 1) % capacity]; }
+        void PushBack(uint32_t capacity, uint32_t value) { items[(head + size++) % capacity] = value; }
+        void PopFront(uint32_t capacity) { head = (head + 1) % capacity; size--; }
+        void PopBack() { size--; }
+    };
+
+    struct Window
+    {
+        Bucket* buckets = nullptr;
+        Deque minQ;             // bucket numbers, minimum strictly increasing
+        Deque maxQ;             // bucket numbers, maximum strictly decreasing
+        uint32_t newest = 0;    // bucket number (timestamp / bucketSeconds)
+        bool empty = true;
+
+        // Running totals over every bucket in the ring
+        uint32_t count = 0;
+        int64_t sum = 0;
+        int64_t sumSq = 0;
+    };
+
+    ServiceProvider& serviceProvider_;
+    InitState initState_;
+    mutable Mutex mutex_;
+    Window windows_[SLOTS][WINDOW_COUNT];
+    bool prewarmed_ = false;
+
+    void PreWarm(uint32_t timestamp);
+    void Insert(size_t slot, size_t window, const TemperaturePoint& point);
+    static void Advance(Window& w, const WindowConfig& cfg, uint32_t bucket);
+};
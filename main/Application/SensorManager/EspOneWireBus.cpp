@@ -0,0 +1,92 @@
+#include "EspOneWireBus.h"
+#include "esp_log.h"
+
+static constexpr const char* TAG = "EspOneWireBus";
+
+EspOneWireBus::~EspOneWireBus()
+{
+    if (handle_)
+        onewire_bus_del(handle_);
+}
+
+bool EspOneWireBus::init(gpio_num_t gpio)
+{
+    gpio_ = gpio;
+
+    onewire_bus_config_t bus_cfg = {
+        .bus_gpio_num = gpio,
+        .flags = {.en_pull_up = 1}
+    };
+    onewire_bus_rmt_config_t rmt_cfg = {
+        .max_rx_bytes = 10
+    };
+
+    esp_err_t err = onewire_new_bus_rmt(&bus_cfg, &rmt_cfg, &handle_);
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "GPIO%d: failed to create bus: %s", gpio_, esp_err_to_name(err));
+        handle_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool EspOneWireBus::reset()
+{
+    // ESP_ERR_NOT_FOUND is a reset without a presence pulse, not an error
+    esp_err_t err = onewire_bus_reset(handle_);
+    if (err != ESP_OK && err != ESP_ERR_NOT_FOUND)
+        ESP_LOGE(TAG, "GPIO%d: reset failed: %s", gpio_, esp_err_to_name(err));
+    return err == ESP_OK;
+}
+
+bool EspOneWireBus::writeBytes(const uint8_t* data, size_t length)
+{
+    esp_err_t err = onewire_bus_write_bytes(handle_, data, static_cast<uint8_t>(length));
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "GPIO%d: write failed: %s", gpio_, esp_err_to_name(err));
+        return false;
+    }
+    return true;
+}
+
+bool EspOneWireBus::readBytes(uint8_t* data, size_t length)
+{
+    esp_err_t err = onewire_bus_read_bytes(handle_, data, length);
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "GPIO%d: read failed: %s", gpio_, esp_err_to_name(err));
+        return false;
+    }
+    return true;
+}
+
+bool EspOneWireBus::writeBit(uint8_t bit)
+{
+    return onewire_bus_write_bit(handle_, bit) == ESP_OK;
+}
+
+bool EspOneWireBus::readBit(uint8_t& bit)
+{
+    return onewire_bus_read_bit(handle_, &bit) == ESP_OK;
+}
+
+bool EspOneWireBus::search(uint64_t* addresses, size_t maxCount, size_t& count)
+{
+    // The driver's iterator does the same search, with its own CRC check
+    count = 0;
+    onewire_device_iter_handle_t iter = nullptr;
+    esp_err_t err = onewire_new_device_iter(handle_, &iter);
+    if (err != ESP_OK)
+    {
+        ESP_LOGE(TAG, "GPIO%d: failed to start search: %s", gpio_, esp_err_to_name(err));
+        return false;
+    }
+
+    onewire_device_t device;
+    while (count < maxCount && onewire_device_iter_get_next(iter, &device) == ESP_OK)
+        addresses[count++] = device.address;
+    onewire_del_device_iter(iter);
+    return true;
+}
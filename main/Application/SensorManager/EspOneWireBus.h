@@ -0,0 +1,28 @@
+#pragma once
+
+#include "onewire_link.h"
+#include "onewire_bus.h"
+#include "driver/gpio.h"
+
+/// IOneWireBus implementation backed by the RMT OneWire driver.
+class EspOneWireBus : public IOneWireBus {
+public:
+    EspOneWireBus() = default;
+    ~EspOneWireBus() override;
+
+    EspOneWireBus(const EspOneWireBus&) = delete;
+    EspOneWireBus& operator=(const EspOneWireBus&) = delete;
+
+    bool init(gpio_num_t gpio);
+
+    bool reset() override;
+    bool writeBytes(const uint8_t* data, size_t length) override;
+    bool readBytes(uint8_t* data, size_t length) override;
+    bool writeBit(uint8_t bit) override;
+    bool readBit(uint8_t& bit) override;
+    bool search(uint64_t* addresses, size_t maxCount, size_t& count) override;
+
+private:
+    onewire_bus_handle_t handle_ = nullptr;
+    gpio_num_t gpio_ = GPIO_NUM_NC;
+};
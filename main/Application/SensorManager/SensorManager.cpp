@@ -1,6 +1,7 @@
 #include "SensorManager.h"
 #include "SettingsManager/SettingsManager.h"
 #include "esp_check.h"
+#include "esp_timer.h"
 #include <algorithm>
 #include <cstdlib>
 #include <cstring>
@@ -18,19 +19,40 @@ void SensorManager::Init()
     if (!init)
         return;
 
-    ESP_LOGI(TAG, "Initializing OneWire bus on GPIO%d", one_wire_gpio);
+    static_assert(BUS_COUNT >= 1 && BUS_COUNT <= 4, "1-4 OneWire buses (two RMT channels each)");
+    static const char *busTaskNames[] = {"OneWire0", "OneWire1", "OneWire2", "OneWire3"};
 
-    onewire_bus_config_t bus_cfg = {
-        .bus_gpio_num = one_wire_gpio,
-        .flags = {.en_pull_up = 1}
-    };
-    onewire_bus_rmt_config_t rmt_cfg = {
-        .max_rx_bytes = 10
-    };
+    LoadTable();
+    PublishSnapshot();
 
-    ESP_ERROR_CHECK(onewire_new_bus_rmt(&bus_cfg, &rmt_cfg, &bus));
+    for (size_t b = 0; b < BUS_COUNT; b++)
+    {
+        Bus &bus = buses[b];
+        bus.gpio = static_cast<gpio_num_t>(BoardConfig::ONEWIRE_PINS[b]);
+        bus.stats.gpio = bus.gpio;
+        bus.publishedStats.gpio = bus.gpio;
 
-    LoadSlotAddresses();
+        if (BoardConfig::ONEWIRE_SIMULATED_SENSORS > 0)
+        {
+            ESP_LOGW(TAG, "Bus %u: simulating %d sensors instead of GPIO%d",
+                     (unsigned)b, BoardConfig::ONEWIRE_SIMULATED_SENSORS, bus.gpio);
+            bus.simulated = CreateSimulatedBus(b);
+            bus.link = bus.simulated.get();
+        }
+        else
+        {
+            ESP_LOGI(TAG, "Initializing OneWire bus %u on GPIO%d", (unsigned)b, bus.gpio);
+
+            // A bus that fails to come up is skipped; the others keep working
+            if (!bus.hardware.init(bus.gpio))
+                continue;
+            bus.link = &bus.hardware;
+        }
+
+        bus.task.Init(busTaskNames[b], 6, 4096);
+        bus.task.SetHandler([this, b]() { BusWork(b); });
+        bus.task.Run();
+    }
 
     task.Init("SensorManager", 6, 4096);
     task.SetHandler([this](){ Work(); });
@@ -41,31 +63,43 @@ void SensorManager::Init()
 
 // ── Slot access (thread-safe) ────────────────────────────────
 
-float SensorManager::GetTemperature(int slot)
+SensorSnapshot SensorManager::GetSnapshot() const
 {
-    WAIT_FOR_READY(initState);
-    LOCK(mutex);
-    if (slot < 0 || slot >= (int)MAX_SENSORS || !slots[slot].active)
-        return 0.0f;
-    return slots[slot].temperatureC;
-}
+    while (true)
+    {
+        // Even = idle, odd = publish in progress. Publish n fills half n & 1,
+        // so half (seq / 2) & 1 is stable until publish (seq / 2) + 2 begins.
+        uint32_t seq = snapshotSeq.load(std::memory_order_acquire);
+        SensorSnapshot copy = snapshots[(seq >> 1) & 1];
+        std::atomic_thread_fence(std::memory_order_acquire);
 
-uint64_t SensorManager::GetSlotAddress(int slot)
-{
-    WAIT_FOR_READY(initState);
-    LOCK(mutex);
-    if (slot < 0 || slot >= (int)MAX_SENSORS)
-        return 0;
-    return slots[slot].configuredAddress;
+        uint32_t limit = (seq | 1) + 2;
+        if (snapshotSeq.load(std::memory_order_relaxed) < limit)
+            return copy;
+    }
 }
 
-bool SensorManager::IsSlotActive(int slot)
+void SensorManager::PublishSnapshot()
 {
-    WAIT_FOR_READY(initState);
-    LOCK(mutex);
-    if (slot < 0 || slot >= (int)MAX_SENSORS)
-        return false;
-    return slots[slot].active;
+    // Called with the mutex held, which serializes writers
+    uint32_t seq = snapshotSeq.load(std::memory_order_relaxed);
+    uint32_t publish = (seq >> 1) + 1;
+    snapshotSeq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    SensorSnapshot &next = snapshots[publish & 1];
+    next.sequence = publish;
+    next.timestampUs = esp_timer_get_time();
+    next.activeMask = 0;
+    for (int s = 0; s < (int)MAX_SENSORS; s++)
+    {
+        next.address[s] = slots[s].address;
+        next.temperatureC[s] = slots[s].temperatureC;
+        if (slots[s].active)
+            next.activeMask |= (1ull << s);
+    }
+
+    snapshotSeq.store(seq + 2, std::memory_order_release);
 }
 
 // ── Pending sensor management ────────────────────────────────
@@ -92,15 +126,14 @@ void SensorManager::AssignPendingToSlot(int slot)
 
     uint64_t address = pendingAddresses[0];
 
-    // Update settings
-    char hexBuf[20];
-    FormatHexAddress(address, hexBuf, sizeof(hexBuf));
-    settingsManager.setString(GetSlotKey(slot), hexBuf);
-    settingsManager.Save();
-
-    // Update slot and trigger rescan
-    slots[slot].configuredAddress = address;
-    rescanRequested = true;
+    // Update slot, persist the table and re-merge; the sensor is already
+    // known on its bus, so no search is needed
+    slots[slot].address = address;
+    slots[slot].active = false;
+    filters[slot] = Filter{};
+    SaveTable();
+    tableChanged = true;
+    PublishSnapshot();
 
     ESP_LOGI(TAG, "Assigned sensor %016" PRIX64 " to slot %d", address, slot);
 
@@ -119,257 +152,957 @@ void SensorManager::DismissPendingSensor()
     pendingCount--;
 }
 
+void SensorManager::RemovePending(uint64_t address)
+{
+    // Called with the mutex held
+    int w = 0;
+    for (int i = 0; i < pendingCount; i++)
+    {
+        if (pendingAddresses[i] != address)
+            pendingAddresses[w++] = pendingAddresses[i];
+    }
+    pendingCount = w;
+}
+
 void SensorManager::ClearAllSlots()
 {
     LOCK(mutex);
     for (int s = 0; s < (int)MAX_SENSORS; s++)
     {
-        settingsManager.setString(GetSlotKey(s), "");
-        slots[s].configuredAddress = 0;
-        if (slots[s].handle)
-        {
-            ds18b20_del_device(slots[s].handle);
-            slots[s].handle = nullptr;
-        }
-        slots[s].active = false;
-        slots[s].temperatureC = 0.0f;
+        slots[s] = SensorEntry{};
+        filters[s] = Filter{};
     }
+    resolutionDirty = ~0ull;
+
+    // Forget what was merged, so every sensor on the buses is offered again
     pendingCount = 0;
-    settingsManager.Save();
-    rescanRequested = true;
+    for (size_t b = 0; b < BUS_COUNT; b++)
+        buses[b].mergedCount = 0;
+
+    PublishSnapshot();
+    SaveTable();
+    tableChanged = true;
     ESP_LOGI(TAG, "All sensor slots cleared");
 }
 
+bool SensorManager::SetResolution(int slot, uint8_t resolutionBits)
+{
+    if (slot < 0 || slot >= (int)MAX_SENSORS || resolutionBits < 9 || resolutionBits > 12)
+        return false;
+
+    {
+        LOCK(mutex);
+        if (slots[slot].resolution == resolutionBits)
+            return true;
+        slots[slot].resolution = resolutionBits;
+        resolutionDirty |= (1ull << slot);
+        SaveTable();
+    }
+    ESP_LOGI(TAG, "Sensor %d resolution set to %u bits", slot, resolutionBits);
+    task.Notify(NOTIFY_WAKE);
+    return true;
+}
+
+uint8_t SensorManager::GetResolution(int slot)
+{
+    LOCK(mutex);
+    if (slot < 0 || slot >= (int)MAX_SENSORS)
+        return 12;
+    return slots[slot].resolution;
+}
+
+// ── Readings & burst mode ────────────────────────────────────
+
+bool SensorManager::AddReadingHandler(ReadingHandler handler)
+{
+    LOCK(mutex);
+    if (readingHandlerCount >= MAX_READING_HANDLERS)
+        return false;
+    readingHandlers[readingHandlerCount++] = std::move(handler);
+    return true;
+}
+
+bool SensorManager::Subscribe(Task &task, uint32_t bits)
+{
+    LOCK(mutex);
+    if (subscriberCount >= MAX_SUBSCRIBERS)
+    {
+        ESP_LOGE(TAG, "Too many reading subscribers");
+        return false;
+    }
+    subscribers[subscriberCount++] = {&task, bits};
+    return true;
+}
+
+bool SensorManager::SubscribePending(Task &task, uint32_t bits)
+{
+    LOCK(mutex);
+    if (pendingSubscriberCount >= MAX_SUBSCRIBERS)
+    {
+        ESP_LOGE(TAG, "Too many pending sensor subscribers");
+        return false;
+    }
+    pendingSubscribers[pendingSubscriberCount++] = {&task, bits};
+    return true;
+}
+
+void SensorManager::SetBurstMode(bool enabled, uint8_t resolutionBits)
+{
+    {
+        LOCK(mutex);
+        if (resolutionBits < 9) resolutionBits = 9;
+        if (resolutionBits > 12) resolutionBits = 12;
+        burstRequested = enabled;
+        burstResolution = resolutionBits;
+    }
+    task.Notify(NOTIFY_WAKE);
+}
+
+bool SensorManager::IsBurstMode()
+{
+    LOCK(mutex);
+    return burstRequested;
+}
+
+SensorManager::BusStats SensorManager::GetBusStats(size_t bus)
+{
+    if (bus >= BUS_COUNT)
+        return {};
+    LOCK(mutex);
+    return buses[bus].publishedStats;
+}
+
+uint32_t SensorManager::ConversionTimeMs(uint8_t resolutionBits)
+{
+    // 93.75 ms at 9 bits, doubling per extra bit (750 ms at 12 bits)
+    if (resolutionBits < 9) resolutionBits = 9;
+    if (resolutionBits > 12) resolutionBits = 12;
+    return (750u >> (12 - resolutionBits)) + 1;
+}
+
+void SensorManager::NotifyReading()
+{
+    // Handlers are only ever added, so the ones counted here stay valid
+    size_t count;
+    {
+        LOCK(mutex);
+        count = readingHandlerCount;
+    }
+    if (count == 0)
+        return;
+
+    // Called without the lock so the handlers can query us
+    SensorSnapshot snap = GetSnapshot();
+    for (size_t i = 0; i < count; i++)
+        readingHandlers[i](snap);
+}
+
+void SensorManager::NotifySubscribers()
+{
+    Subscriber list[MAX_SUBSCRIBERS];
+    size_t count;
+    {
+        LOCK(mutex);
+        count = subscriberCount;
+        std::copy(subscribers, subscribers + count, list);
+    }
+
+    for (size_t i = 0; i < count; i++)
+        list[i].task->Notify(list[i].bits);
+}
+
 // ── Work loop ────────────────────────────────────────────────
 
 void SensorManager::Work()
 {
-    TickType_t lastBusScan = 0;
-    TickType_t lastTemperatureRead = 0;
+    RunOnBuses(OP_SEARCH);
+    MergeScanResults();
+    UpdateResolutions();
 
-    ScanBus();
-    TriggerTemperatureConversions();
+    TickType_t lastCheck = xTaskGetTickCount();
+    TickType_t lastSearch = lastCheck;
+    int64_t nextReadUs = 0;
 
     while (1)
     {
-        TickType_t scanInterval = pdMS_TO_TICKS(settingsManager.getInt("sensor.scan", DEFAULT_SCAN_INTERVAL_MS));
-        TickType_t readInterval = pdMS_TO_TICKS(settingsManager.getInt("sensor.read", DEFAULT_READ_INTERVAL_MS));
+        // Enter or leave burst mode on the bus tasks, between cycles
+        bool burst;
+        uint8_t resolution;
+        uint64_t dirty;
+        bool merge;
+        {
+            LOCK(mutex);
+            burst = burstRequested;
+            resolution = burstResolution;
+            dirty = resolutionDirty;
+            merge = tableChanged;
+            tableChanged = false;
+        }
+        if (merge)
+        {
+            MergeScanResults();
+            UpdateResolutions();
+        }
+        if (burst != burstActive)
+        {
+            busResolution = burst ? resolution : 0;
+            burstActive = burst;
+            UpdateResolutions();
+            nextReadUs = 0;
+            ESP_LOGI(TAG, "Burst mode %s (%u-bit)", burst ? "on" : "off", burst ? resolution : 12);
+        }
+        else if (dirty && !burstActive)
+        {
+            UpdateResolutions();
+        }
 
-        TickType_t now = xTaskGetTickCount();
+        TickType_t checkInterval = pdMS_TO_TICKS(settingsManager.getInt("sensor.scan", DEFAULT_SCAN_INTERVAL_MS));
+        TickType_t searchInterval = pdMS_TO_TICKS(settingsManager.getInt("sensor.search", DEFAULT_SEARCH_INTERVAL_MS));
+        int64_t readIntervalUs = burstActive
+            ? 0
+            : static_cast<int64_t>(settingsManager.getInt("sensor.read", DEFAULT_READ_INTERVAL_MS)) * 1000;
+        medianLength = std::clamp<int32_t>(settingsManager.getInt("sensor.median", DEFAULT_MEDIAN_LENGTH), 1, MAX_MEDIAN_LENGTH);
+        emaShift = std::clamp<int32_t>(settingsManager.getInt("sensor.ema", DEFAULT_EMA_SHIFT), 0, 4);
+
+        uint32_t maxConversionUs = 0;
+        for (size_t b = 0; b < BUS_COUNT; b++)
+            maxConversionUs = std::max(maxConversionUs, buses[b].conversionUs);
+
+        // Start early enough that the slowest bus finishes converting right
+        // at nextReadUs; faster buses start later so every read is fresh
+        int64_t nowUs = esp_timer_get_time();
         bool success = true;
+        if (nowUs >= nextReadUs - maxConversionUs)
+        {
+            cycleDeadlineUs = std::max(nextReadUs, nowUs + maxConversionUs);
+            success = RunOnBuses(OP_CYCLE);
+            lastCycleUs = static_cast<uint32_t>(esp_timer_get_time() - nowUs);
+            {
+                LOCK(mutex);
+                PublishSnapshot();
+            }
+            // Even after a failed read: handlers must see a sensor go missing
+            NotifyReading();
+            NotifySubscribers();
+            nextReadUs = cycleDeadlineUs + readIntervalUs;
+        }
 
-        if (IsElapsed(now, lastTemperatureRead, readInterval))
+        // Presence upkeep: a full search only now and then, a targeted check
+        // on the check interval or right after a failed read. None during a
+        // burst; it would stall the conversion pipeline.
+        TickType_t now = xTaskGetTickCount();
+        if (!burstActive)
         {
-            success &= ReadTemperatures();
-            success &= TriggerTemperatureConversions();
-            lastTemperatureRead = now;
+            uint32_t ops = 0;
+            if (IsElapsed(now, lastSearch, searchInterval))
+                ops = OP_SEARCH;
+            else if (IsElapsed(now, lastCheck, checkInterval) || !success)
+                ops = OP_CHECK;
+
+            if (ops)
+            {
+                RunOnBuses(ops);
+                MergeScanResults();
+                UpdateResolutions();
+                lastCheck = now;
+                if (ops == OP_SEARCH)
+                    lastSearch = now;
+            }
         }
 
-        if (IsElapsed(now, lastBusScan, scanInterval) || (!success) || rescanRequested)
+        if (wakePending)
         {
-            rescanRequested = false;
-            ScanBus();
-            TriggerTemperatureConversions();
-            lastBusScan = now;
+            wakePending = false;
+            continue;
         }
 
-        TickType_t busScanSleep = GetSleepTime(now, lastBusScan, scanInterval);
-        TickType_t tempReadSleep = GetSleepTime(now, lastTemperatureRead, readInterval);
-        TickType_t sleepTime = std::min(busScanSleep, tempReadSleep);
-        vTaskDelay(sleepTime);
+        // Sleep until the next cycle has to start (or the next check is due)
+        int64_t untilCycleUs = nextReadUs - maxConversionUs - esp_timer_get_time();
+        TickType_t cycleSleep = untilCycleUs > 0 ? pdMS_TO_TICKS(untilCycleUs / 1000) : 0;
+        TickType_t checkSleep = std::min(GetSleepTime(now, lastCheck, checkInterval),
+                                         GetSleepTime(now, lastSearch, searchInterval));
+        TickType_t sleepTime = burstActive ? cycleSleep : std::min(checkSleep, cycleSleep);
+        task.NotifyWait(nullptr, sleepTime);
+    }
+}
+
+bool SensorManager::RunOnBuses(uint32_t ops)
+{
+    // Hand the request to every bus task and wait until all are done, so a
+    // cycle takes as long as the busiest bus
+    uint32_t pending = 0;
+    for (size_t b = 0; b < BUS_COUNT; b++)
+    {
+        if (buses[b].link && buses[b].task.Notify(ops))
+            pending |= NOTIFY_BUS_DONE << b;
+    }
+
+    while (pending)
+    {
+        uint32_t bits = 0;
+        task.NotifyWait(&bits, portMAX_DELAY);
+        if (bits & NOTIFY_WAKE)
+            wakePending = true;
+        pending &= ~bits;
     }
+    PublishBusStats();
+
+    bool ok = true;
+    for (size_t b = 0; b < BUS_COUNT; b++)
+        if (buses[b].link) ok &= buses[b].ok;
+    return ok;
 }
 
-// ── Bus scan ─────────────────────────────────────────────────
+void SensorManager::PublishBusStats()
+{
+    // Every bus task is idle here, so its counters are not mid-update
+    LOCK(mutex);
+    for (size_t b = 0; b < BUS_COUNT; b++)
+        buses[b].publishedStats = buses[b].stats;
+}
 
-void SensorManager::ScanBus()
+void SensorManager::MergeScanResults()
 {
-    // Enumerate into local buffers (no lock needed for bus I/O)
-    struct DiscoveredSensor {
-        ds18b20_device_handle_t handle;
-        uint64_t address;
-    };
-    DiscoveredSensor discovered[MAX_SENSORS]{};
-    int discoveredCount = 0;
+    static constexpr uint8_t DS18B20_FAMILY = 0x28;
 
-    onewire_device_iter_handle_t iter = nullptr;
-    ESP_ERROR_CHECK(onewire_new_device_iter(bus, &iter));
+    LOCK(mutex);
 
-    onewire_device_t device;
-    while (onewire_device_iter_get_next(iter, &device) == ESP_OK && discoveredCount < (int)MAX_SENSORS)
+    // Only sensors that appeared or disappeared since the last merge change
+    // state; everything else keeps its row, reading and pending entry
+    int appeared = 0;
+    int disappeared = 0;
+    int offered = 0;
+    for (size_t b = 0; b < BUS_COUNT; b++)
     {
-        ds18b20_config_t ds_cfg = {};
-        ds18b20_device_handle_t handle = nullptr;
-        if (ds18b20_new_device_from_enumeration(&device, &ds_cfg, &handle) == ESP_OK)
+        Bus &bus = buses[b];
+        auto contains = [](const uint64_t *list, int count, uint64_t address) {
+            return std::find(list, list + count, address) != list + count;
+        };
+
+        for (int m = 0; m < bus.mergedCount; m++)
         {
-            onewire_device_address_t addr = 0;
-            ds18b20_get_device_address(handle, &addr);
-            discovered[discoveredCount].handle = handle;
-            discovered[discoveredCount].address = addr;
-            discoveredCount++;
+            uint64_t address = bus.merged[m];
+            if (contains(bus.devices, bus.deviceCount, address))
+                continue;
+
+            // It may come back much warmer or colder; start its filter over
+            int slot = FindSlotByAddress(address);
+            if (slot >= 0)
+            {
+                slots[slot].active = false;
+                filters[slot] = Filter{};
+            }
+            RemovePending(address);
+            disappeared++;
+            ESP_LOGI(TAG, "GPIO%d: %016" PRIX64 " disappeared", bus.gpio, address);
         }
-        else
+
+        for (int d = 0; d < bus.deviceCount; d++)
+        {
+            uint64_t address = bus.devices[d];
+            if (contains(bus.merged, bus.mergedCount, address))
+                continue;
+
+            appeared++;
+            if ((address & 0xFF) != DS18B20_FAMILY)
+                ESP_LOGW(TAG, "GPIO%d: found non-DS18B20 device: %016" PRIX64, bus.gpio, address);
+            else if (FindSlotByAddress(address) < 0 && pendingCount < (int)MAX_SENSORS)
+            {
+                pendingAddresses[pendingCount++] = address;
+                offered++;
+            }
+        }
+
+        memcpy(bus.merged, bus.devices, bus.deviceCount * sizeof(uint64_t));
+        bus.mergedCount = bus.deviceCount;
+
+        // Table rows may have changed even if the bus did not
+        bus.sensorMask = 0;
+        uint32_t sensors = 0;
+        for (int d = 0; d < bus.deviceCount; d++)
+        {
+            if ((bus.devices[d] & 0xFF) != DS18B20_FAMILY)
+                continue;
+            sensors++;
+            int slot = FindSlotByAddress(bus.devices[d]);
+            if (slot >= 0)
+                bus.sensorMask |= (1ull << slot);
+        }
+        bus.stats.sensors = sensors;
+        bus.publishedStats.sensors = sensors;
+
+        // A sensor that dropped off may come back with its power-on resolution
+        bus.resolutionMask &= bus.sensorMask;
+    }
+
+    // Rows whose sensor is on no bus (unassigned or reassigned) go inactive
+    uint64_t present = 0;
+    for (size_t b = 0; b < BUS_COUNT; b++)
+        present |= buses[b].sensorMask;
+    for (int s = 0; s < (int)MAX_SENSORS; s++)
+    {
+        if (!((present >> s) & 1))
+            slots[s].active = false;
+    }
+
+    PublishSnapshot();
+
+    if (appeared || disappeared)
+        ESP_LOGI(TAG, "Bus change: %d appeared, %d disappeared, %d pending", appeared, disappeared, pendingCount);
+
+    // Notify never blocks, so this is fine under the lock
+    if (offered)
+    {
+        for (size_t i = 0; i < pendingSubscriberCount; i++)
+            pendingSubscribers[i].task->Notify(pendingSubscribers[i].bits);
+    }
+}
+
+bool SensorManager::UpdateResolutions()
+{
+    // Push changed or not yet applied resolutions to the sensors
+    bool needApply = false;
+    {
+        LOCK(mutex);
+        uint64_t dirty = resolutionDirty;
+        resolutionDirty = 0;
+        for (size_t b = 0; b < BUS_COUNT; b++)
         {
-            ESP_LOGW(TAG, "Found non-DS18B20 device: %016" PRIX64, device.address);
+            buses[b].resolutionMask &= ~dirty;
+            if (buses[b].sensorMask & ~buses[b].resolutionMask)
+                needApply = true;
         }
     }
-    onewire_del_device_iter(iter);
+    bool ok = needApply ? RunOnBuses(OP_RESOLUTION) : true;
 
-    // Now take the lock briefly to reconcile with slots
+    // Each bus waits for its slowest sensor
     LOCK(mutex);
+    for (size_t b = 0; b < BUS_COUNT; b++)
+    {
+        Bus &bus = buses[b];
+        uint32_t conversionMs = 0;
+        for (int s = 0; s < (int)MAX_SENSORS; s++)
+        {
+            if ((bus.sensorMask >> s) & 1)
+                conversionMs = std::max(conversionMs, ConversionTimeMs(busResolution ? busResolution : slots[s].resolution));
+        }
+        bus.conversionUs = conversionMs * 1000;
+    }
+    return ok;
+}
+
+// ── Bus tasks ────────────────────────────────────────────────
+
+void SensorManager::BusWork(size_t index)
+{
+    Bus &bus = buses[index];
+
+    while (1)
+    {
+        uint32_t ops = 0;
+        bus.task.NotifyWait(&ops, portMAX_DELAY);
 
-    // Reload addresses in case they changed (assignment from UI)
-    LoadSlotAddresses();
+        bool ok = true;
+        if (ops & OP_SEARCH)
+            ok &= SearchBus(bus);
+        if (ops & OP_CHECK)
+            ok &= CheckBus(bus);
+        if (ops & OP_RESOLUTION)
+            ok &= ApplyResolution(bus);
+        if (ops & OP_CYCLE)
+            ok &= RunCycle(bus);
 
-    // Free old handles
-    ClearSlotHandles();
+        bus.ok = ok;
+        task.Notify(NOTIFY_BUS_DONE << index);
+    }
+}
 
-    // Match discovered sensors to configured slots
-    bool matched[MAX_SENSORS] = {};
-    for (int d = 0; d < discoveredCount; d++)
+bool SensorManager::SearchBus(Bus &bus)
+{
+    // Every family is kept: they all take part in the search tree that
+    // CheckBus predicts
+    size_t count = 0;
+    if (!bus.link->search(bus.devices, MAX_SENSORS, count))
     {
-        int slot = FindSlotByAddress(discovered[d].address);
-        if (slot >= 0)
+        bus.stats.errors++;
+        return false;
+    }
+    bus.deviceCount = static_cast<int>(count);
+
+    bus.failedMask = 0;
+    bus.stats.searches++;
+    return true;
+}
+
+bool SensorManager::CheckBus(Bus &bus)
+{
+    // Nothing known here: any presence pulse means something was plugged in
+    if (bus.deviceCount == 0)
+        return bus.link->reset() ? SearchBus(bus) : true;
+
+    // Sensors whose read failed: gone, or just a bad read? Only the ones
+    // that fail a targeted search twice are dropped.
+    if (bus.failedMask)
+    {
+        SensorSnapshot snap = GetSnapshot();
+        uint64_t branches;
+        for (int s = 0; s < (int)MAX_SENSORS; s++)
         {
-            slots[slot].handle = discovered[d].handle;
-            slots[slot].active = true;
-            matched[d] = true;
+            if (!((bus.failedMask >> s) & 1))
+                continue;
+            if (!VerifyDevice(bus, snap.address[s], branches) && !VerifyDevice(bus, snap.address[s], branches))
+                RemoveDevice(bus, snap.address[s]);
         }
+        bus.failedMask = 0;
+        if (bus.deviceCount == 0)
+            return true;
     }
 
-    // Unmatched discovered sensors go to pending queue
-    pendingCount = 0;
-    for (int d = 0; d < discoveredCount; d++)
+    // Walk one known device's search path per check, round robin. A new
+    // device branches off the path of the known device it shares the
+    // longest ROM prefix with, at a bit where no known device does; a lost
+    // one removes a branch. Either way the tree no longer matches.
+    bus.checkNext = (bus.checkNext + 1) % bus.deviceCount;
+    uint64_t address = bus.devices[bus.checkNext];
+    uint64_t branches = 0;
+    if (VerifyDevice(bus, address, branches) && branches == ExpectedBranches(bus, address))
+        return true;
+
+    ESP_LOGI(TAG, "GPIO%d: bus topology changed, searching", bus.gpio);
+    return SearchBus(bus);
+}
+
+bool SensorManager::VerifyDevice(Bus &bus, uint64_t address, uint64_t &branches)
+{
+    // Search ROM forced down the path of one address: one pass of the
+    // search, where a full search needs one pass per device. Bits where
+    // both values answered are reported as branches.
+    branches = 0;
+    const uint8_t cmd = 0xF0;               // Search ROM
+    if (!bus.link->reset() || !bus.link->writeBytes(&cmd, 1))
+        return false;
+
+    for (int i = 0; i < 64; i++)
     {
-        if (!matched[d])
+        uint8_t bit = 0;
+        uint8_t complement = 0;
+        uint8_t wanted = (address >> i) & 1;
+        if (!bus.link->readBit(bit) || !bus.link->readBit(complement))
         {
-            // Check it's not already pending or assigned
-            if (pendingCount < (int)MAX_SENSORS)
-            {
-                pendingAddresses[pendingCount++] = discovered[d].address;
-            }
-            // Free handle for unassigned sensors
-            ds18b20_del_device(discovered[d].handle);
+            bus.stats.errors++;
+            return false;
+        }
+
+        if (bit && complement)
+            return false;                   // nobody left on this path
+        if (!bit && !complement)
+            branches |= (1ull << i);
+        else if (bit != wanted)
+            return false;                   // only devices with the other value
+
+        if (!bus.link->writeBit(wanted))
+        {
+            bus.stats.errors++;
+            return false;
         }
     }
+    return true;
+}
 
-    int activeCount = 0;
-    for (int s = 0; s < (int)MAX_SENSORS; s++)
-        if (slots[s].active) activeCount++;
+uint64_t SensorManager::ExpectedBranches(const Bus &bus, uint64_t address)
+{
+    // Every other device leaves the path at its first differing ROM bit
+    uint64_t branches = 0;
+    for (int d = 0; d < bus.deviceCount; d++)
+    {
+        uint64_t diff = bus.devices[d] ^ address;
+        if (diff)
+            branches |= (1ull << __builtin_ctzll(diff));
+    }
+    return branches;
+}
 
-    if (pendingCount > 0)
-        ESP_LOGI(TAG, "Scan: %d new sensor(s) found", pendingCount);
+void SensorManager::RemoveDevice(Bus &bus, uint64_t address)
+{
+    for (int d = 0; d < bus.deviceCount; d++)
+    {
+        if (bus.devices[d] == address)
+        {
+            bus.devices[d] = bus.devices[--bus.deviceCount];
+            return;
+        }
+    }
 }
 
-bool SensorManager::TriggerTemperatureConversions()
+bool SensorManager::RunCycle(Bus &bus)
 {
-    LOCK(mutex);
+    if (bus.sensorMask == 0)
+        return true;
 
-    bool anyActive = false;
-    for (int s = 0; s < (int)MAX_SENSORS; s++)
-        if (slots[s].active) { anyActive = true; break; }
+    // Start so the conversion completes at the shared deadline, then read
+    // as soon as it has
+    DelayUntilUs(cycleDeadlineUs - bus.conversionUs);
+    if (!TriggerTemperatureConversions(bus))
+        return false;
+    DelayUntilUs(esp_timer_get_time() + bus.conversionUs);
+    return ReadTemperatures(bus);
+}
 
-    if (!anyActive)
+void SensorManager::DelayUntilUs(int64_t timeUs)
+{
+    int64_t remainingUs = timeUs - esp_timer_get_time();
+    if (remainingUs <= 0)
+        return;
+
+    // Round up and add a tick: vTaskDelay(n) can return up to a tick early,
+    // which would read an unfinished conversion
+    constexpr int64_t tickUs = portTICK_PERIOD_MS * 1000;
+    vTaskDelay(static_cast<TickType_t>((remainingUs + tickUs - 1) / tickUs + 1));
+}
+
+bool SensorManager::TriggerTemperatureConversions(Bus &bus)
+{
+    if (bus.deviceCount == 0)
         return true;
 
-    esp_err_t err = onewire_bus_reset(bus);
-    if (err != ESP_OK)
+    if (!bus.link->reset())
     {
-        ESP_LOGE(TAG, "OneWire reset failed: %s", esp_err_to_name(err));
+        bus.stats.errors++;
+        ESP_LOGE(TAG, "GPIO%d: no presence pulse", bus.gpio);
         return false;
     }
 
-    uint8_t cmd;
-    cmd = 0xCC; // Skip ROM
-    err = onewire_bus_write_bytes(bus, &cmd, 1);
-    if (err != ESP_OK)
+    // One broadcast starts a conversion on every sensor on the bus
+    const uint8_t cmd[] = {
+        0xCC,   // Skip ROM
+        0x44,   // Convert T
+    };
+    if (!bus.link->writeBytes(cmd, sizeof(cmd)))
     {
-        ESP_LOGE(TAG, "Failed to send Skip ROM: %s", esp_err_to_name(err));
+        bus.stats.errors++;
+        ESP_LOGE(TAG, "GPIO%d: failed to send Convert T", bus.gpio);
         return false;
     }
 
-    cmd = 0x44; // Convert T
-    err = onewire_bus_write_bytes(bus, &cmd, 1);
-    if (err != ESP_OK)
+    return true;
+}
+
+bool SensorManager::ApplyResolution(Bus &bus)
+{
+    // Burst override: one broadcast, and every sensor needs its own setting
+    // back afterwards
+    if (busResolution != 0)
+    {
+        bus.resolutionMask = 0;
+        return WriteConfig(bus, nullptr, busResolution);
+    }
+
+    uint64_t addresses[MAX_SENSORS];
+    uint8_t wanted[MAX_SENSORS];
+    bool uniform = true;
     {
-        ESP_LOGE(TAG, "Failed to send Convert T: %s", esp_err_to_name(err));
-        return false;
+        LOCK(mutex);
+        for (int s = 0; s < (int)MAX_SENSORS; s++)
+        {
+            addresses[s] = slots[s].address;
+            wanted[s] = slots[s].resolution;
+        }
     }
 
+    int first = -1;
+    for (int s = 0; s < (int)MAX_SENSORS; s++)
+    {
+        if (!((bus.sensorMask >> s) & 1))
+            continue;
+        if (first < 0)
+            first = s;
+        else if (wanted[s] != wanted[first])
+            uniform = false;
+    }
+    if (first < 0)
+        return true;
+
+    // Same resolution everywhere: one Skip ROM broadcast covers the bus
+    if (uniform)
+    {
+        if (!WriteConfig(bus, nullptr, wanted[first]))
+            return false;
+        bus.resolutionMask = bus.sensorMask;
+        return true;
+    }
+
+    bool ok = true;
+    uint64_t todo = bus.sensorMask & ~bus.resolutionMask;
+    for (int s = 0; s < (int)MAX_SENSORS; s++)
+    {
+        if (!((todo >> s) & 1))
+            continue;
+        if (WriteConfig(bus, &addresses[s], wanted[s]))
+            bus.resolutionMask |= (1ull << s);
+        else
+            ok = false;
+    }
+    return ok;
+}
+
+bool SensorManager::WriteConfig(Bus &bus, const uint64_t *address, uint8_t resolutionBits)
+{
+    // Write Scratchpad to one sensor (Match ROM) or all of them (Skip ROM).
+    // TH/TL are set to the range limits so no sensor answers an alarm search.
+    uint8_t cmd[13];
+    size_t len = 0;
+    if (address)
+    {
+        cmd[len++] = 0x55;                  // Match ROM
+        memcpy(&cmd[len], address, sizeof(*address));
+        len += sizeof(*address);
+    }
+    else
+    {
+        cmd[len++] = 0xCC;                  // Skip ROM
+    }
+    cmd[len++] = 0x4E;                      // Write Scratchpad
+    cmd[len++] = 0x7F;                      // TH
+    cmd[len++] = 0x80;                      // TL
+    cmd[len++] = static_cast<uint8_t>(((resolutionBits - 9) << 5) | 0x1F);   // Config
+
+    if (!bus.link->reset() || !bus.link->writeBytes(cmd, len))
+    {
+        bus.stats.errors++;
+        ESP_LOGW(TAG, "GPIO%d: failed to set %u-bit resolution", bus.gpio, resolutionBits);
+        return false;
+    }
     return true;
 }
 
-bool SensorManager::ReadTemperatures()
+bool SensorManager::ReadTemperatures(Bus &bus)
 {
-    LOCK(mutex);
-    bool success = true;
+    // Read the bus's sensors with Match ROM without holding the lock, so the
+    // UI and the other buses never wait on a full pass. A good read also
+    // confirms the sensor is still there.
+    int64_t start = esp_timer_get_time();
+    SensorSnapshot snap = GetSnapshot();
+    uint64_t mine = bus.sensorMask;
+    int16_t readings[MAX_SENSORS];
+    uint64_t readMask = 0;
+    uint64_t failedMask = 0;
 
     for (int s = 0; s < (int)MAX_SENSORS; s++)
     {
-        if (!slots[s].active || !slots[s].handle)
+        if (!((mine >> s) & 1))
             continue;
 
-        esp_err_t err = ds18b20_get_temperature(slots[s].handle, &slots[s].temperatureC);
-        if (err != ESP_OK)
+        // One retry: a single CRC error on a long cable is common
+        if (ReadScratchpad(bus, snap.address[s], readings[s]) || ReadScratchpad(bus, snap.address[s], readings[s]))
+            readMask |= (1ull << s);
+        else
+            failedMask |= (1ull << s);
+    }
+
+    {
+        LOCK(mutex);
+        for (int s = 0; s < (int)MAX_SENSORS; s++)
         {
-            success = false;
-            slots[s].active = false;
-            ESP_LOGE(TAG, "Failed to read slot %d: %s", s, esp_err_to_name(err));
+            // Skip rows that were reassigned while we were reading
+            if (!((mine >> s) & 1) || slots[s].address != snap.address[s])
+                continue;
+
+            int32_t filtered;
+            if (((readMask >> s) & 1) && FilterReading(s, readings[s], filtered))
+            {
+                slots[s].temperatureC = filtered / static_cast<float>(1 << (4 + EMA_FRACTION_BITS));
+                slots[s].active = true;
+            }
+            else if ((readMask >> s) & 1)
+            {
+                // Present but implausible: keep the previous value
+                bus.stats.rejected++;
+                ESP_LOGW(TAG, "GPIO%d: sensor %d read %d/16 °C, dropped", bus.gpio, s, readings[s]);
+            }
+            else
+            {
+                // Verified on the next check; only this row goes inactive
+                slots[s].active = false;
+                bus.failedMask |= (1ull << s);
+                bus.stats.errors++;
+                ESP_LOGE(TAG, "GPIO%d: failed to read sensor %d (%016" PRIX64 ")", bus.gpio, s, slots[s].address);
+            }
         }
     }
-    return success;
+
+    bus.stats.lastReadUs = static_cast<uint32_t>(esp_timer_get_time() - start);
+    if (bus.stats.lastReadUs > bus.stats.maxReadUs)
+        bus.stats.maxReadUs = bus.stats.lastReadUs;
+    return failedMask == 0;
 }
 
-// ── Helpers ──────────────────────────────────────────────────
+bool SensorManager::ReadScratchpad(Bus &bus, uint64_t address, int16_t &raw)
+{
+    uint8_t cmd[10];
+    cmd[0] = 0x55;                          // Match ROM
+    memcpy(&cmd[1], &address, sizeof(address));
+    cmd[9] = 0xBE;                          // Read Scratchpad
+
+    uint8_t scratchpad[9] = {};
+    if (!bus.link->reset()
+        || !bus.link->writeBytes(cmd, sizeof(cmd))
+        || !bus.link->readBytes(scratchpad, sizeof(scratchpad)))
+        return false;
+
+    // An all-zero scratchpad (shorted line) passes the CRC
+    bool allZero = std::all_of(scratchpad, scratchpad + sizeof(scratchpad), [](uint8_t b) { return b == 0; });
+    if (allZero || IOneWireBus::crc8(scratchpad, 8) != scratchpad[8])
+        return false;
 
-void SensorManager::LoadSlotAddresses()
+    // Undefined low bits depend on the resolution in the config register
+    uint8_t resolution = (scratchpad[4] >> 5) & 0x03;   // 0 = 9 bit .. 3 = 12 bit
+    raw = static_cast<int16_t>(scratchpad[0] | (scratchpad[1] << 8));
+    raw &= ~((1 << (3 - resolution)) - 1);
+    return true;
+}
+
+bool SensorManager::FilterReading(int id, int16_t raw, int32_t &filtered)
 {
-    for (int s = 0; s < (int)MAX_SENSORS; s++)
+    // Called with the mutex held. Counts are 1/16 °C.
+    static constexpr int16_t RAW_MIN = -55 * 16;        // DS18B20 range
+    static constexpr int16_t RAW_MAX = 125 * 16;
+    static constexpr int16_t RAW_POWER_ON = 85 * 16;    // scratchpad before the first conversion
+
+    Filter &f = filters[id];
+    if (raw < RAW_MIN || raw > RAW_MAX)
+        return false;
+
+    // Once there is history the median takes care of a stray 85 °C; before
+    // that only a repeated one is believed
+    if (f.count == 0 && raw == RAW_POWER_ON && !f.powerOnSeen)
     {
-        char hexBuf[20] = {};
-        if (settingsManager.getString(GetSlotKey(s), hexBuf, sizeof(hexBuf)) && hexBuf[0] != '\0')
-            slots[s].configuredAddress = ParseHexAddress(hexBuf);
-        else
-            slots[s].configuredAddress = 0;
+        f.powerOnSeen = true;
+        return false;
     }
+
+    if (f.length != medianLength)
+    {
+        f.count = 0;
+        f.next = 0;
+        f.length = medianLength;
+    }
+    f.window[f.next] = raw;
+    f.next = (f.next + 1) % f.length;
+    if (f.count < f.length)
+        f.count++;
+
+    int16_t sorted[MAX_MEDIAN_LENGTH];
+    std::copy(f.window, f.window + f.count, sorted);
+    std::sort(sorted, sorted + f.count);
+    int32_t median = static_cast<int32_t>(sorted[f.count / 2]) << EMA_FRACTION_BITS;
+
+    // No smoothing on the first value, or during a burst where the lag
+    // would blur the transient being captured
+    if (f.count == 1 || emaShift == 0 || burstActive)
+        f.ema = median;
+    else
+        f.ema += (median - f.ema + (1 << (emaShift - 1))) >> emaShift;
+
+    filtered = f.ema;
+    return true;
 }
 
-int SensorManager::FindSlotByAddress(uint64_t address)
+// ── Helpers ──────────────────────────────────────────────────
+
+std::unique_ptr<SimOneWireBus> SensorManager::CreateSimulatedBus(size_t index)
 {
-    if (address == 0) return -1;
-    for (int s = 0; s < (int)MAX_SENSORS; s++)
+    // Spread over a plausible range, with the noise, dropouts and CRC errors
+    // of a long cable, so every error path downstream gets exercised
+    auto bus = std::make_unique<SimOneWireBus>(static_cast<uint32_t>(esp_timer_get_time()) + index);
+    for (int i = 0; i < BoardConfig::ONEWIRE_SIMULATED_SENSORS; i++)
     {
-        if (slots[s].configuredAddress == address)
-            return s;
+        SimDevice device;
+        device.rom = SimOneWireBus::makeRom((static_cast<uint64_t>(index) << 16) | (i + 1));
+        device.temperatureC = 15.0f + (i % 40) * 0.5f;
+        device.noiseC = 0.05f;
+        device.dropoutRate = 0.001f;
+        device.crcErrorRate = 0.002f;
+        bus->addDevice(device);
     }
-    return -1;
+    return bus;
 }
 
-void SensorManager::ClearSlotHandles()
+void SensorManager::LoadTable()
 {
-    for (int s = 0; s < (int)MAX_SENSORS; s++)
+    // Per-id resolution, one byte each (0 = default)
+    uint8_t resolutions[MAX_SENSORS] = {};
+    size_t resLen = sizeof(resolutions);
+    if (settingsManager.getBlob(RESOLUTION_KEY, resolutions, resLen))
+    {
+        for (size_t s = 0; s < resLen; s++)
+            if (resolutions[s] >= 9 && resolutions[s] <= 12)
+                slots[s].resolution = resolutions[s];
+    }
+
+    // Stored compactly as the ROM codes of ids 0..n-1 (0 = free)
+    uint64_t addresses[MAX_SENSORS] = {};
+    size_t len = sizeof(addresses);
+    if (settingsManager.getBlob(TABLE_KEY, addresses, len))
+    {
+        for (size_t s = 0; s < len / sizeof(uint64_t); s++)
+            slots[s].address = addresses[s];
+        return;
+    }
+
+    // First boot after the upgrade: take over the four per-slot settings
+    static const char* legacyKeys[] = {"sensor.0", "sensor.1", "sensor.2", "sensor.3"};
+    bool migrated = false;
+    for (int s = 0; s < 4; s++)
     {
-        if (slots[s].handle)
+        char hexBuf[20] = {};
+        if (settingsManager.getString(legacyKeys[s], hexBuf, sizeof(hexBuf)) && hexBuf[0] != '\0')
         {
-            ds18b20_del_device(slots[s].handle);
-            slots[s].handle = nullptr;
+            slots[s].address = ParseHexAddress(hexBuf);
+            migrated = true;
         }
-        slots[s].active = false;
+    }
+    if (migrated)
+    {
+        ESP_LOGI(TAG, "Migrated slot assignments to the sensor table");
+        SaveTable();
     }
 }
 
-const char* SensorManager::GetSlotKey(int slot)
+void SensorManager::SaveTable()
 {
-    static const char* keys[] = {"sensor.0", "sensor.1", "sensor.2", "sensor.3"};
-    return keys[slot];
+    uint64_t addresses[MAX_SENSORS] = {};
+    uint8_t resolutions[MAX_SENSORS] = {};
+    size_t count = 1;   // NVS does not take empty blobs
+    size_t resCount = 1;
+    for (size_t s = 0; s < MAX_SENSORS; s++)
+    {
+        addresses[s] = slots[s].address;
+        if (addresses[s] != 0)
+            count = s + 1;
+        if (slots[s].resolution != 12)
+        {
+            resolutions[s] = slots[s].resolution;
+            resCount = s + 1;
+        }
+    }
+
+    settingsManager.setBlob(TABLE_KEY, addresses, count * sizeof(uint64_t));
+    settingsManager.setBlob(RESOLUTION_KEY, resolutions, resCount);
+    settingsManager.Save();
 }
 
-uint64_t SensorManager::ParseHexAddress(const char* str)
+int SensorManager::FindSlotByAddress(uint64_t address)
 {
-    return strtoull(str, nullptr, 16);
+    if (address == 0) return -1;
+    for (int s = 0; s < (int)MAX_SENSORS; s++)
+    {
+        if (slots[s].address == address)
+            return s;
+    }
+    return -1;
 }
 
-void SensorManager::FormatHexAddress(uint64_t addr, char* buf, size_t size)
+uint64_t SensorManager::ParseHexAddress(const char* str)
 {
-    snprintf(buf, size, "%016" PRIX64, addr);
+    return strtoull(str, nullptr, 16);
 }
@@ -1,37 +1,53 @@
 #pragma once
 #include "ServiceProvider.h"
+#include "BoardConfig.h"
 #include "rtos.h"
 #include "driver/gpio.h"
 #include "esp_log.h"
-#include "onewire_bus.h"
-#include "ds18b20.h"
+#include "EspOneWireBus.h"
+#include "sim_onewire.h"
+#include "SensorSnapshot.h"
+#include <atomic>
+#include <functional>
+#include <memory>
 
 class SettingsManager;
 
-struct SensorSlot
+/// One row of the sensor table. The row index is the sensor id; ids 0-3 are
+/// the colour-coded channels (Red, Blue, Green, Yellow) shown on the display.
+struct SensorEntry
 {
-    uint64_t configuredAddress = 0;   // from settings (0 = unassigned)
-    ds18b20_device_handle_t handle = nullptr;
+    uint64_t address = 0;             // OneWire ROM code (0 = free row)
     float temperatureC = 0.0f;
-    bool active = false;              // true if sensor found on bus
+    bool active = false;              // present on a bus and its last read succeeded
+    uint8_t resolution = 12;          // configured conversion resolution, 9-12 bits
 };
 
 class SensorManager
 {
     inline static constexpr const char *TAG = "SensorManager";
-    static constexpr size_t MAX_SENSORS = 4;
     static constexpr int32_t DEFAULT_SCAN_INTERVAL_MS = 5000;
+    static constexpr int32_t DEFAULT_SEARCH_INTERVAL_MS = 60000;
+    static constexpr int32_t DEFAULT_MEDIAN_LENGTH = 3;
+    static constexpr int32_t DEFAULT_EMA_SHIFT = 2;
+    static constexpr int MAX_MEDIAN_LENGTH = 5;
     static constexpr int32_t DEFAULT_READ_INTERVAL_MS = 1000;
+    static constexpr const char *TABLE_KEY = "sensor.table";
+    static constexpr const char *RESOLUTION_KEY = "sensor.res";
 
 public:
+    static constexpr size_t MAX_SENSORS = SensorSnapshot::MAX_SENSORS;
+    static constexpr size_t CHANNEL_COUNT = 4;      // ids with a colour, chart line and history
+    static constexpr size_t BUS_COUNT = BoardConfig::ONEWIRE_BUS_COUNT;
+
     explicit SensorManager(ServiceProvider &ctx);
 
     void Init();
 
-    // Slot-based access (slot 0=Red, 1=Blue, 2=Green, 3=Yellow)
-    float GetTemperature(int slot);
-    uint64_t GetSlotAddress(int slot);
-    bool IsSlotActive(int slot);
+    /// Wait-free copy of the sensor table, indexed by sensor id (0=Red,
+    /// 1=Blue, 2=Green, 3=Yellow, then 4..MAX_SENSORS-1). Never blocks on the
+    /// bus or the sensor mutex.
+    SensorSnapshot GetSnapshot() const;
 
     // Pending sensor management (thread-safe, called from LVGL task)
     bool HasPendingSensor();
@@ -40,30 +56,171 @@ public:
     void DismissPendingSensor();
     void ClearAllSlots();
 
+    /// Conversion resolution for a sensor id (9-12 bits, 94-750 ms). Lower
+    /// resolution lets its bus cycle faster. Persisted; applied between cycles.
+    bool SetResolution(int slot, uint8_t resolutionBits);
+    uint8_t GetResolution(int slot);
+
+    /// Called from the sensor task after every read cycle, failed ones
+    /// included, in the order they were added. Handlers must not block.
+    using ReadingHandler = std::function<void(const SensorSnapshot &snapshot)>;
+    bool AddReadingHandler(ReadingHandler handler);
+
+    /// Wake `task` with notification `bits` after every read cycle, once its
+    /// snapshot is published. Wakes a slow subscriber missed merge into one;
+    /// the snapshot sequence tells how many cycles it skipped.
+    bool Subscribe(Task &task, uint32_t bits);
+
+    /// Wake `task` with notification `bits` when a merge adds sensors to the
+    /// pending queue, so the queue does not have to be polled.
+    bool SubscribePending(Task &task, uint32_t bits);
+
+    /// Burst mode: back-to-back conversions at the given resolution (9-12 bits)
+    /// and no bus scans until it is switched off again.
+    void SetBurstMode(bool enabled, uint8_t resolutionBits = 12);
+    bool IsBurstMode();
+
+    /// DS18B20 conversion time for a resolution, in ms (93.75 ms at 9 bits, doubling per bit).
+    static uint32_t ConversionTimeMs(uint8_t resolutionBits);
+
+    struct BusStats
+    {
+        int gpio;
+        uint32_t sensors;           // DS18B20s currently known on the bus
+        uint32_t searches;          // full ROM searches since boot
+        uint32_t lastReadUs;        // duration of the last read pass
+        uint32_t maxReadUs;
+        uint32_t errors;            // failed resets and reads (after retry)
+        uint32_t rejected;          // good reads dropped by the filter (out of range, power-on value)
+    };
+
+    /// Counters of one bus as of its last completed request, copied whole.
+    BusStats GetBusStats(size_t bus);
+    /// Wall time of the last cycle, conversion plus reads. All buses run in
+    /// parallel, so this follows the slowest bus rather than the sensor count.
+    uint32_t GetLastCycleUs() const { return lastCycleUs; }
+
 private:
+    // Work for a bus task, as notification bits. Run in this order.
+    static constexpr uint32_t OP_SEARCH = 1u << 0;     // full ROM search
+    static constexpr uint32_t OP_CHECK = 1u << 1;      // targeted presence check, searches on a change
+    static constexpr uint32_t OP_RESOLUTION = 1u << 2;
+    static constexpr uint32_t OP_CYCLE = 1u << 3;      // convert, then read when done
+
+    // Notification bits for the coordinating task
+    static constexpr uint32_t NOTIFY_WAKE = 1u << 0;        // re-check burst mode
+    static constexpr uint32_t NOTIFY_BUS_DONE = 1u << 8;    // shifted by the bus index
+
+    /// One OneWire bus with its own RMT channels (or a simulation) and
+    /// acquisition task. The bus is only ever driven from that task.
+    struct Bus
+    {
+        gpio_num_t gpio = GPIO_NUM_NC;
+        IOneWireBus *link = nullptr;        // hardware or simulated; null if the bus failed
+        EspOneWireBus hardware;
+        std::unique_ptr<SimOneWireBus> simulated;
+        Task task;
+        uint64_t devices[MAX_SENSORS] = {}; // ROM codes present, any family; owned by the bus task
+        int deviceCount = 0;
+        int checkNext = 0;                  // round-robin position for OP_CHECK
+        uint64_t failedMask = 0;            // ids whose read failed, verified on the next check
+        uint64_t merged[MAX_SENSORS] = {};  // devices as of the last merge; owned by the coordinator
+        int mergedCount = 0;
+        uint64_t sensorMask = 0;            // table ids on this bus, set on merge
+        uint64_t resolutionMask = 0;        // ids whose scratchpad has the wanted resolution
+        uint32_t conversionUs = 0;          // slowest conversion among its sensors
+        bool ok = true;                     // outcome of the last request
+        BusStats stats = {};                // written by the bus task during a request
+        BusStats publishedStats = {};       // copy between requests; guarded by mutex
+    };
+
     SettingsManager &settingsManager;
     InitState initState;
     RecursiveMutex mutex;
     Task task;
 
     void Work();
-    void ScanBus();
-    bool TriggerTemperatureConversions();
-    bool ReadTemperatures();
+    bool RunOnBuses(uint32_t ops);
+    void PublishBusStats();
+    void MergeScanResults();
+    bool UpdateResolutions();
+    void PublishSnapshot();
+    void NotifyReading();
+    void NotifySubscribers();
+
+    // Bus task side
+    void BusWork(size_t index);
+    bool SearchBus(Bus &bus);
+    bool CheckBus(Bus &bus);
+    bool VerifyDevice(Bus &bus, uint64_t address, uint64_t &branches);
+    static uint64_t ExpectedBranches(const Bus &bus, uint64_t address);
+    static void RemoveDevice(Bus &bus, uint64_t address);
+    bool RunCycle(Bus &bus);
+    bool TriggerTemperatureConversions(Bus &bus);
+    bool ReadTemperatures(Bus &bus);
+    bool ReadScratchpad(Bus &bus, uint64_t address, int16_t &raw);
+    bool FilterReading(int id, int16_t raw, int32_t &filtered);
+    bool ApplyResolution(Bus &bus);
+    bool WriteConfig(Bus &bus, const uint64_t *address, uint8_t resolutionBits);
+    static void DelayUntilUs(int64_t timeUs);
 
-    void LoadSlotAddresses();
+    void LoadTable();
+    void SaveTable();
     int FindSlotByAddress(uint64_t address);
-    void ClearSlotHandles();
+    void RemovePending(uint64_t address);
 
-    static const char* GetSlotKey(int slot);
     static uint64_t ParseHexAddress(const char* str);
-    static void FormatHexAddress(uint64_t addr, char* buf, size_t size);
+    static std::unique_ptr<SimOneWireBus> CreateSimulatedBus(size_t index);
 
-    gpio_num_t one_wire_gpio = GPIO_NUM_4;
-    onewire_bus_handle_t bus = nullptr;
-    SensorSlot slots[MAX_SENSORS]{};
+    Bus buses[BUS_COUNT];
+    uint8_t busResolution = 0;      // for OP_RESOLUTION: 9-12 = burst override, 0 = per sensor
+    int64_t cycleDeadlineUs = 0;    // for OP_CYCLE: when every bus should read
+    uint64_t resolutionDirty = 0;   // ids whose resolution changed since the last cycle
+    bool wakePending = false;
+    uint32_t lastCycleUs = 0;
+    SensorEntry slots[MAX_SENSORS]{};
+
+    /// Per-id filter between the raw reads and the snapshot: median of the
+    /// last N raw counts rejects spikes, then an EMA with alpha = 2^-shift
+    /// smooths the ±1 LSB jitter. Integer only; the EMA keeps 4 extra bits.
+    struct Filter
+    {
+        int16_t window[MAX_MEDIAN_LENGTH];
+        uint8_t count;
+        uint8_t next;
+        uint8_t length;             // median length the window was filled with
+        bool powerOnSeen;           // one 85 °C read was dropped already
+        int32_t ema;                // 1/256 °C
+    };
+    static constexpr int EMA_FRACTION_BITS = 4;    // on top of the 4 in a raw count
+    Filter filters[MAX_SENSORS]{};
+    uint8_t medianLength = DEFAULT_MEDIAN_LENGTH;   // set by the coordinator per cycle
+    uint8_t emaShift = DEFAULT_EMA_SHIFT;
 
     uint64_t pendingAddresses[MAX_SENSORS]{};
     int pendingCount = 0;
-    bool rescanRequested = false;
+    bool tableChanged = false;      // re-merge without touching the bus
+
+    // Seqlock over a double buffer: while one half is being written, readers
+    // copy the other one, so they only retry if the writer laps them twice.
+    SensorSnapshot snapshots[2]{};
+    std::atomic<uint32_t> snapshotSeq{0};
+
+    static constexpr size_t MAX_READING_HANDLERS = 2;
+    ReadingHandler readingHandlers[MAX_READING_HANDLERS];
+    size_t readingHandlerCount = 0;
+
+    struct Subscriber
+    {
+        Task *task;
+        uint32_t bits;
+    };
+    static constexpr size_t MAX_SUBSCRIBERS = 4;
+    Subscriber subscribers[MAX_SUBSCRIBERS] = {};
+    size_t subscriberCount = 0;
+    Subscriber pendingSubscribers[MAX_SUBSCRIBERS] = {};
+    size_t pendingSubscriberCount = 0;
+    bool burstRequested = false;
+    bool burstActive = false;
+    uint8_t burstResolution = 12;
 };
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/// Consistent copy of the sensor table, published once per read cycle.
+/// Plain data with no ESP-IDF dependency, so the host build uses it as is.
+struct SensorSnapshot
+{
+    static constexpr size_t MAX_SENSORS = 64;
+
+    uint32_t sequence = 0;          // bumps on every publish; 0 = nothing published yet
+    int64_t timestampUs = 0;        // esp_timer time of the publish
+    uint64_t activeMask = 0;        // bit n set = sensor n present and read
+    uint64_t address[MAX_SENSORS] = {};
+    float temperatureC[MAX_SENSORS] = {};
+
+    bool IsActive(int id) const { return id >= 0 && id < (int)MAX_SENSORS && ((activeMask >> id) & 1); }
+};
@@ -1,13 +1,17 @@
 #pragma once
 
+class AlarmManager;
+class BurstManager;
 class CommandManager;
 class DeviceManager;
 class DisplayManager;
+class HistoryCache;
 class HomeAssistantManager;
 class ConsoleManager;
 class LogManager;
 class MqttManager;
 class NetworkManager;
+class RollingStats;
 class SensorManager;
 class SettingsManager;
 class MonitorManager;
@@ -18,14 +22,18 @@ class WebServerManager;
 class ServiceProvider
 {
 public:
+    virtual AlarmManager& getAlarmManager() = 0;
+    virtual BurstManager& getBurstManager() = 0;
     virtual CommandManager& getCommandManager() = 0;
     virtual DeviceManager& getDeviceManager() = 0;
     virtual DisplayManager& getDisplayManager() = 0;
+    virtual HistoryCache& getHistoryCache() = 0;
     virtual HomeAssistantManager& getHomeAssistantManager() = 0;
     virtual ConsoleManager& getConsoleManager() = 0;
     virtual LogManager& getLogManager() = 0;
     virtual MqttManager& getMqttManager() = 0;
     virtual NetworkManager& getNetworkManager() = 0;
+    virtual RollingStats& getRollingStats() = 0;
     virtual SensorManager& getSensorManager() = 0;
     virtual SettingsManager& getSettingsManager() = 0;
     virtual MonitorManager& getMonitorManager() = 0;
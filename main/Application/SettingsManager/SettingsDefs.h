@@ -28,19 +28,76 @@ inline const SettingDef SETTINGS_DEFS[] = {
     { "ntp.timezone",  SettingType::String, "Timezone (POSIX)", "CET-1CEST,M3.5.0,M10.5.0/3" },
 
     // Temperature history & graph
-    { "history.rate",  SettingType::Int, "History Sample Rate (s)", "10" },
+    { "monitor.rate",  SettingType::Int, "Sample Rate (s)",         "10" },
     { "graph.min",     SettingType::Int, "Graph Min Temperature",   "0" },
     { "graph.max",     SettingType::Int, "Graph Max Temperature",   "100" },
 
+    // Screen saver: dim, then switch off (no rendering) after this long
+    // without a touch; 0 = never
+    { "display.dim",    SettingType::Int, "Screen Dim After (s)",  "0" },
+    { "display.off",    SettingType::Int, "Screen Off After (s)",  "0" },
+    { "display.bright", SettingType::Int, "Brightness (%)",        "50" },
+    { "display.dimpct", SettingType::Int, "Dimmed Brightness (%)", "20" },
+
+    // Change-driven logging: write a slot only when it moves more than the
+    // deadband, plus a full entry every heartbeat
+    { "log.deadband",  SettingType::Int, "Log Deadband (0.01 °C)",  "10" },
+    { "log.heartbeat", SettingType::Int, "Log Heartbeat (s)",       "600" },
+
+    // Burst capture (high-rate recording of short transients)
+    { "burst.pre",     SettingType::Int, "Burst Pre-Trigger (s)",   "30" },
+    { "burst.dur",     SettingType::Int, "Burst Duration (s)",      "120" },
+    { "burst.res",     SettingType::Int, "Burst Resolution (9-12 bit)", "10" },
+    { "burst.trigger", SettingType::Bool, "Burst Threshold Trigger", "false" },
+    { "burst.thresh",  SettingType::Int, "Burst Trigger (°C)",      "0" },
+
     // Sensor timing (milliseconds)
-    { "sensor.scan",   SettingType::Int, "Bus Scan Interval (ms)",  "5000" },
+    { "sensor.scan",   SettingType::Int, "Bus Check Interval (ms)", "5000" },
+    { "sensor.search", SettingType::Int, "Bus Search Interval (ms)", "60000" },
     { "sensor.read",   SettingType::Int, "Temp Read Interval (ms)", "1000" },
 
-    // Sensor slot addresses (hex string of 64-bit OneWire address, empty = unassigned)
-    { "sensor.0",      SettingType::String, "Sensor Slot 1 (Red)",    "" },
-    { "sensor.1",      SettingType::String, "Sensor Slot 2 (Blue)",   "" },
-    { "sensor.2",      SettingType::String, "Sensor Slot 3 (Green)",  "" },
-    { "sensor.3",      SettingType::String, "Sensor Slot 4 (Yellow)", "" },
+    // Per-sensor filter: median of N raw reads (1 = off), then an EMA with
+    // alpha = 1/2^shift (0 = off)
+    { "sensor.median", SettingType::Int, "Median Filter (1-5 reads)", "3" },
+    { "sensor.ema",    SettingType::Int, "EMA Shift (0-4)",         "2" },
+
+    // Alarms per colour channel, each limit with its own enable, in 0.1 °C
+    // (rate in 0.1 °C/min). Cleared once the reading is back past the limit
+    // by the hysteresis; the rate alarm has its own, in 0.1 °C/min.
+    { "alarm1.highon",   SettingType::Bool,   "Alarm Red High Enabled",               "false" },
+    { "alarm1.high",     SettingType::Int,    "Alarm Red High (0.1 °C)",              "0" },
+    { "alarm1.lowon",    SettingType::Bool,   "Alarm Red Low Enabled",                "false" },
+    { "alarm1.low",      SettingType::Int,    "Alarm Red Low (0.1 °C)",               "0" },
+    { "alarm1.hyst",     SettingType::Int,    "Alarm Red Hysteresis (0.1 °C)",        "5" },
+    { "alarm1.rateon",   SettingType::Bool,   "Alarm Red Rate Enabled",               "false" },
+    { "alarm1.rate",     SettingType::Int,    "Alarm Red Rate (0.1 °C/min)",          "0" },
+    { "alarm1.ratehyst", SettingType::Int,    "Alarm Red Rate Hyst. (0.1 °C/min)",    "5" },
+    { "alarm2.highon",   SettingType::Bool,   "Alarm Blue High Enabled",              "false" },
+    { "alarm2.high",     SettingType::Int,    "Alarm Blue High (0.1 °C)",             "0" },
+    { "alarm2.lowon",    SettingType::Bool,   "Alarm Blue Low Enabled",               "false" },
+    { "alarm2.low",      SettingType::Int,    "Alarm Blue Low (0.1 °C)",              "0" },
+    { "alarm2.hyst",     SettingType::Int,    "Alarm Blue Hysteresis (0.1 °C)",       "5" },
+    { "alarm2.rateon",   SettingType::Bool,   "Alarm Blue Rate Enabled",              "false" },
+    { "alarm2.rate",     SettingType::Int,    "Alarm Blue Rate (0.1 °C/min)",         "0" },
+    { "alarm2.ratehyst", SettingType::Int,    "Alarm Blue Rate Hyst. (0.1 °C/min)",   "5" },
+    { "alarm3.highon",   SettingType::Bool,   "Alarm Green High Enabled",             "false" },
+    { "alarm3.high",     SettingType::Int,    "Alarm Green High (0.1 °C)",            "0" },
+    { "alarm3.lowon",    SettingType::Bool,   "Alarm Green Low Enabled",              "false" },
+    { "alarm3.low",      SettingType::Int,    "Alarm Green Low (0.1 °C)",             "0" },
+    { "alarm3.hyst",     SettingType::Int,    "Alarm Green Hysteresis (0.1 °C)",      "5" },
+    { "alarm3.rateon",   SettingType::Bool,   "Alarm Green Rate Enabled",             "false" },
+    { "alarm3.rate",     SettingType::Int,    "Alarm Green Rate (0.1 °C/min)",        "0" },
+    { "alarm3.ratehyst", SettingType::Int,    "Alarm Green Rate Hyst. (0.1 °C/min)",  "5" },
+    { "alarm4.highon",   SettingType::Bool,   "Alarm Yellow High Enabled",            "false" },
+    { "alarm4.high",     SettingType::Int,    "Alarm Yellow High (0.1 °C)",           "0" },
+    { "alarm4.lowon",    SettingType::Bool,   "Alarm Yellow Low Enabled",             "false" },
+    { "alarm4.low",      SettingType::Int,    "Alarm Yellow Low (0.1 °C)",            "0" },
+    { "alarm4.hyst",     SettingType::Int,    "Alarm Yellow Hysteresis (0.1 °C)",     "5" },
+    { "alarm4.rateon",   SettingType::Bool,   "Alarm Yellow Rate Enabled",            "false" },
+    { "alarm4.rate",     SettingType::Int,    "Alarm Yellow Rate (0.1 °C/min)",       "0" },
+    { "alarm4.ratehyst", SettingType::Int,    "Alarm Yellow Rate Hyst. (0.1 °C/min)", "5" },
+
+    // Sensor assignments are kept by SensorManager as the "sensor.table" blob
 };
 
 inline constexpr int SETTINGS_DEFS_COUNT = sizeof(SETTINGS_DEFS) / sizeof(SETTINGS_DEFS[0]);
@@ -135,6 +135,24 @@ bool SettingsManager::setBool(const char* key, bool value)
     return handle_->set_item<uint8_t>(key, value ? 1 : 0) == ESP_OK;
 }
 
+bool SettingsManager::getBlob(const char* key, void* out, size_t& len) const
+{
+    if (!handle_) return false;
+    size_t size = 0;
+    if (handle_->get_item_size(nvs::ItemType::BLOB, key, size) != ESP_OK || size > len)
+        return false;
+    if (handle_->get_blob(key, out, size) != ESP_OK)
+        return false;
+    len = size;
+    return true;
+}
+
+bool SettingsManager::setBlob(const char* key, const void* data, size_t len)
+{
+    if (!handle_) return false;
+    return handle_->set_blob(key, data, len) == ESP_OK;
+}
+
 // ──────────────────────────────────────────────────────────────
 // Persistence
 // ──────────────────────────────────────────────────────────────
@@ -46,6 +46,11 @@ public:
     bool getBool(const char* key, bool defaultVal = false) const;
     bool setBool(const char* key, bool value);
 
+    /// Raw bytes for state that is not a user setting (not in SETTINGS_DEFS).
+    /// `len` is the buffer size on entry and the stored size on return.
+    bool getBlob(const char* key, void* out, size_t& len) const;
+    bool setBlob(const char* key, const void* data, size_t len);
+
     // ── Persistence ──────────────────────────────────────────
 
     bool Save();
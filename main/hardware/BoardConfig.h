@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 // ──────────────────────────────────────────────────────────────
 // Board configuration — hardware-specific pin assignments and constants.
 // Edit this file to match your board or target MCU.
@@ -13,6 +15,22 @@ namespace BoardConfig
     static constexpr int LED_PIN = 2;
     static constexpr bool LED_ACTIVE_HIGH = true;
 
+    // OneWire buses, one per GPIO, each with a 4.7k pull-up. Every bus takes
+    // an RMT TX and RX channel, so the ESP32 supports up to four.
+    static constexpr int ONEWIRE_PINS[] = { 4 };
+    static constexpr size_t ONEWIRE_BUS_COUNT = sizeof(ONEWIRE_PINS) / sizeof(ONEWIRE_PINS[0]);
+
+    // Load testing without hardware: replace every bus with this many
+    // simulated DS18B20s. 0 = use the real buses.
+    static constexpr int ONEWIRE_SIMULATED_SENSORS = 0;
+
+    // LVGL draw buffers (two), in display lines of 480 px. Up to 40 lines
+    // come from internal DMA RAM; 320 = full frame, placed in PSRAM, which
+    // the SPI driver cannot DMA from. Those are sent 40 lines at a time
+    // through one internal bounce buffer, so LVGL waits for all but the
+    // last 40 lines of each flush.
+    static constexpr int DISPLAY_BUFFER_LINES = 32;
+
     // Add project-specific pin definitions below.
     // Examples:
     //   static constexpr int MODBUS_TX_PIN = 17;
@@ -1,7 +1,11 @@
 #include "Display_WT32SC01.h"
 #include "esp_lcd_st7796.h"
 #include "esp_lcd_touch_ft5x06.h"
+#include "esp_heap_caps.h"
+#include "BoardConfig.h"
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 Display_WT32SC01::~Display_WT32SC01()
 {
@@ -11,6 +15,9 @@ Display_WT32SC01::~Display_WT32SC01()
         esp_lcd_touch_del(touch);
     free(buf1);
     free(buf2);
+    free(bounce);
+    if (flushDone)
+        vSemaphoreDelete(flushDone);
 }
 
 void Display_WT32SC01::Init()
@@ -22,7 +29,7 @@ void Display_WT32SC01::Init()
     buscfg.sclk_io_num = LCD_CLK;
     buscfg.mosi_io_num = LCD_MOSI;
     buscfg.miso_io_num = -1;
-    buscfg.max_transfer_sz = LCD_HRES * 40 * sizeof(uint16_t);
+    buscfg.max_transfer_sz = LCD_HRES * TRANSFER_LINES * sizeof(uint16_t);
     ESP_ERROR_CHECK(spi_bus_initialize(SPI2_HOST, &buscfg, SPI_DMA_CH_AUTO));
 
     // --- SPI IO config ---
@@ -34,6 +41,8 @@ void Display_WT32SC01::Init()
     io_cfg.lcd_cmd_bits = 8;
     io_cfg.lcd_param_bits = 8;
     io_cfg.trans_queue_depth = 10;
+    io_cfg.on_color_trans_done = OnColorTransDone;
+    io_cfg.user_ctx = this;
     ESP_ERROR_CHECK(esp_lcd_new_panel_io_spi(SPI2_HOST, &io_cfg, &io));
 
     // --- ST7796 panel config ---
@@ -48,31 +57,67 @@ void Display_WT32SC01::Init()
     ESP_ERROR_CHECK(esp_lcd_panel_swap_xy(panel, true));
     ESP_ERROR_CHECK(esp_lcd_panel_disp_on_off(panel, true));
 
+    flushDone = xSemaphoreCreateBinary();
+    assert(flushDone);
+
     // --- Backlight ---
     InitBacklight();
 
     // --- LVGL display setup ---
-    size_t buf_pixels = LCD_HRES * 32;
-    buf1 = (lv_color_t *)heap_caps_malloc(buf_pixels * sizeof(lv_color_t), MALLOC_CAP_DMA);
-    buf2 = (lv_color_t *)heap_caps_malloc(buf_pixels * sizeof(lv_color_t), MALLOC_CAP_DMA);
-    assert(buf1 && buf2);
-
-    lv_disp_draw_buf_init(&drawBuf, buf1, buf2, buf_pixels);
+    AllocateBuffers();
+    lv_disp_draw_buf_init(&drawBuf, buf1, buf2, LCD_HRES * bufferLines);
 
+    // Flushes complete asynchronously: flush_cb only queues the DMA, and the
+    // transfer-done ISR tells LVGL, so it renders into the other buffer
+    // while this one is still going out
     lv_disp_drv_init(&dispDrv);
     dispDrv.flush_cb = LvglFlushCb;
+    dispDrv.wait_cb = LvglWaitCb;
+    dispDrv.monitor_cb = LvglMonitorCb;
     dispDrv.draw_buf = &drawBuf;
     dispDrv.hor_res = LCD_HRES;
     dispDrv.ver_res = LCD_VRES;
     dispDrv.user_data = this;
     disp = lv_disp_drv_register(&dispDrv);
 
-    ESP_LOGI(TAG, "WT32-SC01 LVGL display registered");
+    ESP_LOGI(TAG, "WT32-SC01 LVGL display registered (2 x %d lines in %s)",
+             bufferLines, bufferInPsram ? "PSRAM" : "internal RAM");
 
     // --- Touch ---
     InitTouch();
 }
 
+void Display_WT32SC01::AllocateBuffers()
+{
+    bufferLines = std::clamp(BoardConfig::DISPLAY_BUFFER_LINES, 1, LCD_VRES);
+    size_t bytes = LCD_HRES * bufferLines * sizeof(lv_color_t);
+
+    // Internal DMA RAM unless a full frame is asked for; fall back to PSRAM
+    // when the buffers do not fit
+    if (bufferLines < LCD_VRES)
+    {
+        buf1 = (lv_color_t *)heap_caps_malloc(bytes, MALLOC_CAP_DMA);
+        buf2 = (lv_color_t *)heap_caps_malloc(bytes, MALLOC_CAP_DMA);
+    }
+    if (!buf1 || !buf2)
+    {
+        free(buf1);
+        free(buf2);
+        buf1 = (lv_color_t *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        buf2 = (lv_color_t *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+        bufferInPsram = true;
+    }
+    assert(buf1 && buf2);
+
+    // The SPI driver cannot DMA from PSRAM and would allocate an internal
+    // copy of every queued transfer; flushes go through this one instead
+    if (bufferInPsram)
+    {
+        bounce = (lv_color_t *)heap_caps_malloc(LCD_HRES * TRANSFER_LINES * sizeof(lv_color_t), MALLOC_CAP_DMA);
+        assert(bounce);
+    }
+}
+
 void Display_WT32SC01::InitTouch()
 {
     ESP_LOGI(TAG, "Initializing FT6336 touch controller");
@@ -115,6 +160,8 @@ void Display_WT32SC01::InitTouch()
     tp_cfg.flags.swap_xy = true;
     tp_cfg.flags.mirror_x = true;
     tp_cfg.flags.mirror_y = false;
+    tp_cfg.interrupt_callback = OnTouchInterrupt;
+    tp_cfg.user_data = this;
 
     err = esp_lcd_touch_new_i2c_ft5x06(tp_io, &tp_cfg, &touch);
     if (err != ESP_OK)
@@ -132,6 +179,10 @@ void Display_WT32SC01::InitTouch()
     indev_drv.user_data = this;
     inputDev = lv_indev_drv_register(&indev_drv);
 
+    // Event driven: no polling until the first interrupt
+    touchIrqEnabled = true;
+    lv_timer_pause(indev_drv.read_timer);
+
     ESP_LOGI(TAG, "FT6336 touch initialized successfully");
 }
 
@@ -142,20 +193,73 @@ void Display_WT32SC01::LvglTouchCb(lv_indev_drv_t *drv, lv_indev_data_t *data)
     if (!self || !self->touch)
         return;
 
-    esp_lcd_touch_read_data(self->touch);
+    // Nothing to read unless the controller signalled or a press is still
+    // being tracked; the release ends polling until the next interrupt
+    if (self->touchIrqEnabled && !self->touchIrq && !self->touchActive)
+    {
+        data->state = LV_INDEV_STATE_RELEASED;
+        lv_timer_pause(drv->read_timer);
+        return;
+    }
+    self->touchIrq = false;
 
-    uint16_t x, y;
-    uint8_t points = 1;
-    if (esp_lcd_touch_get_coordinates(self->touch, &x, &y, NULL, &points, 1) && points > 0) {
-        data->point.x = x;
-        data->point.y = y;
+    esp_lcd_touch_read_data(self->touch);
+    self->counters.touchReads++;
+
+    uint16_t x[MAX_TOUCH_POINTS], y[MAX_TOUCH_POINTS];
+    uint8_t points = 0;
+    if (esp_lcd_touch_get_coordinates(self->touch, x, y, NULL, &points, MAX_TOUCH_POINTS) && points > 0) {
+        self->touchCount = points;
+        for (uint8_t i = 0; i < points; i++)
+            self->touchPoints[i] = {(lv_coord_t)x[i], (lv_coord_t)y[i]};
+        data->point.x = x[0];
+        data->point.y = y[0];
         data->state = LV_INDEV_STATE_PRESSED;
-        ESP_LOGD(TAG, "Touch: x=%d y=%d", x, y);
+        self->touchActive = true;
+        ESP_LOGD(TAG, "Touch: x=%d y=%d (%u points)", x[0], y[0], points);
     } else {
+        self->touchCount = 0;
+        self->touchActive = false;
         data->state = LV_INDEV_STATE_RELEASED;
+        if (self->touchIrqEnabled && !self->touchIrq)
+            lv_timer_pause(drv->read_timer);
     }
 }
 
+void Display_WT32SC01::OnTouchInterrupt(esp_lcd_touch_handle_t tp)
+{
+    // ISR context: flag it and wake the LVGL task, which resumes the reads
+    auto *self = static_cast<Display_WT32SC01 *>(tp->config.user_data);
+    if (!self)
+        return;
+    self->touchIrq = true;
+    self->counters.touchIrqs++;
+    if (self->touchWake)
+        self->touchWake(self->touchWakeCtx);
+}
+
+void Display_WT32SC01::IgnoreUntilRelease()
+{
+    if (inputDev)
+        lv_indev_wait_release(inputDev);
+}
+
+void Display_WT32SC01::ServiceTouch()
+{
+    if (!inputDev || !touchIrq)
+        return;
+    lv_timer_t *timer = inputDev->driver->read_timer;
+    lv_timer_resume(timer);
+    lv_timer_ready(timer);
+}
+
+uint8_t Display_WT32SC01::GetTouchPoints(lv_point_t *out) const
+{
+    for (uint8_t i = 0; i < touchCount; i++)
+        out[i] = touchPoints[i];
+    return touchCount;
+}
+
 
 void Display_WT32SC01::LvglFlushCb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
 {
@@ -165,16 +269,88 @@ void Display_WT32SC01::LvglFlushCb(lv_disp_drv_t *drv, const lv_area_t *area, lv
         return;
     }
 
-    esp_err_t err = esp_lcd_panel_draw_bitmap(
-        self->panel,
-        area->x1, area->y1,
-        area->x2 + 1, area->y2 + 1,
-        color_p);
+    // Sending the window blocks until the previous transfer is done
+    int64_t start = esp_timer_get_time();
+    xSemaphoreTake(self->flushDone, 0);
+
+    esp_err_t err;
+    if (self->bounce)
+    {
+        err = self->FlushThroughBounce(area, color_p);
+    }
+    else
+    {
+        self->flushFinal = true;
+        self->flushing = true;
+        err = esp_lcd_panel_draw_bitmap(
+            self->panel,
+            area->x1, area->y1,
+            area->x2 + 1, area->y2 + 1,
+            color_p);
+    }
 
     if (err != ESP_OK)
+    {
         ESP_LOGE(TAG, "Flush failed: %s", esp_err_to_name(err));
+        self->flushing = false;
+        lv_disp_flush_ready(drv);
+    }
+    self->counters.blockedUs += esp_timer_get_time() - start;
+}
 
-    lv_disp_flush_ready(drv);
+esp_err_t Display_WT32SC01::FlushThroughBounce(const lv_area_t *area, const lv_color_t *colors)
+{
+    // Copy the area out in strips of TRANSFER_LINES, each one after the
+    // previous has been sent. Only the last strip overlaps with rendering,
+    // so PSRAM buffers trade some of the double buffering for their size
+    int width = area->x2 - area->x1 + 1;
+    int strip = std::max(1, LCD_HRES * TRANSFER_LINES / width);
+
+    for (int y = area->y1; y <= area->y2; y += strip)
+    {
+        int lines = std::min(strip, area->y2 + 1 - y);
+        if (y != area->y1 && xSemaphoreTake(flushDone, pdMS_TO_TICKS(100)) != pdTRUE)
+            return ESP_ERR_TIMEOUT;
+
+        memcpy(bounce, colors + (y - area->y1) * width, width * lines * sizeof(lv_color_t));
+        flushFinal = y + lines > area->y2;
+        flushing = true;
+        esp_err_t err = esp_lcd_panel_draw_bitmap(panel, area->x1, y, area->x2 + 1, y + lines, bounce);
+        if (err != ESP_OK)
+            return err;
+    }
+    return ESP_OK;
+}
+
+void Display_WT32SC01::LvglWaitCb(lv_disp_drv_t *drv)
+{
+    // LVGL calls this in a loop until the flush is ready; block instead of spinning
+    auto *self = static_cast<Display_WT32SC01 *>(drv->user_data);
+    int64_t start = esp_timer_get_time();
+    xSemaphoreTake(self->flushDone, pdMS_TO_TICKS(20));
+    self->counters.blockedUs += esp_timer_get_time() - start;
+}
+
+void Display_WT32SC01::LvglMonitorCb(lv_disp_drv_t *drv, uint32_t time, uint32_t px)
+{
+    auto *self = static_cast<Display_WT32SC01 *>(drv->user_data);
+    self->counters.frames++;
+}
+
+bool Display_WT32SC01::OnColorTransDone(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t *edata, void *userCtx)
+{
+    // ISR context; only fires for color data, once per draw_bitmap
+    auto *self = static_cast<Display_WT32SC01 *>(userCtx);
+    if (!self->flushing)
+        return false;
+
+    self->flushing = false;
+    if (self->flushFinal)
+        lv_disp_flush_ready(&self->dispDrv);
+
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(self->flushDone, &woken);
+    return woken == pdTRUE;
 }
 
 
@@ -9,6 +9,8 @@
 #include "esp_lcd_touch_ft5x06.h"
 #include "esp_log.h"
 #include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 
 class Display_WT32SC01
 {
@@ -27,6 +29,10 @@ class Display_WT32SC01
     static constexpr gpio_num_t TOUCH_SCL = GPIO_NUM_19;
     static constexpr gpio_num_t TOUCH_INT = GPIO_NUM_39;
 
+    // Largest single SPI transfer, and the height of the bounce buffer
+    // PSRAM draw buffers are copied through
+    static constexpr int TRANSFER_LINES = 40;
+
 public:
     static constexpr int LCD_HRES = 480;
     static constexpr int LCD_VRES = 320;
@@ -34,9 +40,35 @@ public:
     Display_WT32SC01() = default;
     ~Display_WT32SC01();
 
+    /// Running totals since Init, updated from the LVGL task.
+    struct Counters
+    {
+        uint32_t frames;        // completed refreshes
+        uint64_t blockedUs;     // time LVGL spent in flush_cb or waiting for the DMA
+        uint32_t touchIrqs;     // TOUCH_INT edges
+        uint32_t touchReads;    // I2C reads of the touch controller
+    };
+
+    /// Called from the touch interrupt (ISR context) to wake the LVGL task.
+    using WakeFunc = void (*)(void *ctx);
+
     void Init();
     void SetBrightness(uint8_t percent);
+    void SetTouchWakeHandler(WakeFunc func, void *ctx) { touchWake = func; touchWakeCtx = ctx; }
+    /// Resume input reads after a touch interrupt. LVGL task only.
+    void ServiceTouch();
+    /// Ignore the current press until it is released (e.g. the touch that
+    /// woke the screen). LVGL task only.
+    void IgnoreUntilRelease();
     lv_disp_t* GetLvglDisplay() const { return disp; }
+    Counters GetCounters() const { return counters; }
+    int GetBufferLines() const { return bufferLines; }
+    bool IsBufferInPsram() const { return bufferInPsram; }
+
+    /// Points of the last touch read (LVGL only sees the first); for gestures
+    /// such as pinch. Only valid in the LVGL task.
+    static constexpr uint8_t MAX_TOUCH_POINTS = 2;
+    uint8_t GetTouchPoints(lv_point_t *out) const;
 
 private:
     // --- Display ---
@@ -44,17 +76,42 @@ private:
     lv_disp_draw_buf_t drawBuf;
     lv_color_t *buf1 = nullptr;
     lv_color_t *buf2 = nullptr;
+    lv_color_t *bounce = nullptr;       // internal DMA RAM, only with PSRAM buffers
     lv_disp_drv_t dispDrv;
     lv_disp_t *disp = nullptr;
+    int bufferLines = 0;
+    bool bufferInPsram = false;
+
+    // Flush completion, signalled from the SPI transfer-done ISR
+    SemaphoreHandle_t flushDone = nullptr;
+    volatile bool flushing = false;
+    volatile bool flushFinal = false;   // last transfer of the area; completes the LVGL flush
+    Counters counters = {};
 
     // --- Touch ---
     i2c_master_bus_handle_t i2cBus = nullptr;
     esp_lcd_touch_handle_t touch = nullptr;
     lv_indev_t *inputDev = nullptr;
+    lv_point_t touchPoints[MAX_TOUCH_POINTS] = {};
+    uint8_t touchCount = 0;
+
+    // Reads are gated by TOUCH_INT: the LVGL read timer is paused while
+    // nothing touches the panel and resumed by the interrupt
+    volatile bool touchIrq = false;
+    bool touchIrqEnabled = false;
+    bool touchActive = false;
+    WakeFunc touchWake = nullptr;
+    void *touchWakeCtx = nullptr;
 
     // --- Methods ---
     void InitBacklight();
     void InitTouch();
+    void AllocateBuffers();
+    esp_err_t FlushThroughBounce(const lv_area_t *area, const lv_color_t *colors);
     static void LvglFlushCb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p);
+    static void LvglWaitCb(lv_disp_drv_t *drv);
+    static void LvglMonitorCb(lv_disp_drv_t *drv, uint32_t time, uint32_t px);
+    static bool OnColorTransDone(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t *edata, void *userCtx);
     static void LvglTouchCb(lv_indev_drv_t *drv, lv_indev_data_t *data);
+    static void OnTouchInterrupt(esp_lcd_touch_handle_t tp);
 };
@@ -178,10 +178,26 @@ public:
         return *this;
     }
 
+    JsonWriter& value(uint32_t v)
+    {
+        comma();
+        char buf[16];
+        snprintf(buf, sizeof(buf), "%" PRIu32, v);
+        raw(buf);
+        return *this;
+    }
+
     JsonWriter& value(bool v)
     {
         comma();
         raw(v ? "true" : "false");
         return *this;
     }
+
+    JsonWriter& nullValue()
+    {
+        comma();
+        raw("null");
+        return *this;
+    }
 };
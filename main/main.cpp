@@ -17,16 +17,21 @@ extern "C" void app_main(void)
     ESP_LOGI(TAG, "Starting up...");
     g_appContext.getConsoleManager().Init();
     g_appContext.getLogManager().Init();
+    // HistoryCache pre-warm reads monitor.rate and log.heartbeat
     g_appContext.getSettingsManager().Init();
+    g_appContext.getHistoryCache().Init();
+    g_appContext.getRollingStats().Init();
     g_appContext.getNetworkManager().Init();
     g_appContext.getTimeManager().Init();
     g_appContext.getSensorManager().Init();
     g_appContext.getMonitorManager().Init();
+    g_appContext.getAlarmManager().Init();
     g_appContext.getDisplayManager().Init();
     g_appContext.getCommandManager().Init();
     g_appContext.getMqttManager().Init();
     g_appContext.getDeviceManager().Init();
     g_appContext.getHomeAssistantManager().Init();
+    g_appContext.getBurstManager().Init();
     g_appContext.getUpdateManager().Init();
     g_appContext.getWebServerManager().Init();
 